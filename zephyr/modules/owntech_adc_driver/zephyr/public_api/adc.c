@@ -39,6 +39,7 @@
 
 #define NUMBER_OF_ADCS 5
 #define NUMBER_OF_CHANNELS_PER_ADC 16
+#define NUMBER_OF_INJECTED_CHANNELS_PER_ADC 4
 
 
 /////
@@ -48,9 +49,31 @@ static adc_ev_src_t adc_trigger_sources[NUMBER_OF_ADCS]    = {0};
 static uint32_t     adc_discontinuous_mode[NUMBER_OF_ADCS] = {0};
 static uint32_t     enabled_channels_count[NUMBER_OF_ADCS] = {0};
 static bool         enable_dma[NUMBER_OF_ADCS]             = {0};
+static uint32_t     oversampling_ratio[NUMBER_OF_ADCS]     = {1, 1, 1, 1, 1};
+static uint32_t     oversampling_shift[NUMBER_OF_ADCS]     = {0};
+static adc_ovs_mode_t oversampling_mode[NUMBER_OF_ADCS]    = {ovs_continuous};
 
 static uint32_t     enabled_channels[NUMBER_OF_ADCS][NUMBER_OF_CHANNELS_PER_ADC] = {0};
 
+static adc_ev_src_t adc_injected_trigger_sources[NUMBER_OF_ADCS]  = {0};
+static uint8_t      injected_channels_count[NUMBER_OF_ADCS]       = {0};
+static uint8_t      injected_channels[NUMBER_OF_ADCS][NUMBER_OF_INJECTED_CHANNELS_PER_ADC] = {0};
+
+static bool         dual_mode = false;
+
+
+/////
+// Private functions
+
+/**
+ * In dual mode, ADC 2 is slave of ADC 1: it is neither
+ * triggered nor started on its own.
+ */
+static bool _adc_is_dual_slave(uint8_t adc_number)
+{
+	return (adc_number == 2) && (adc_get_dual_mode() == true);
+}
+
 
 /////
 // Public API
@@ -128,6 +151,145 @@ void adc_configure_use_dma(uint8_t adc_number, bool use_dma)
 	enable_dma[adc_number-1] = use_dma;
 }
 
+int8_t adc_add_injected_channel(uint8_t adc_number, uint8_t channel)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return -1;
+
+	uint8_t adc_index = adc_number-1;
+
+	if (injected_channels_count[adc_index] == NUMBER_OF_INJECTED_CHANNELS_PER_ADC)
+		return -1;
+
+	injected_channels[adc_index][injected_channels_count[adc_index]] = channel;
+	injected_channels_count[adc_index]++;
+
+	return injected_channels_count[adc_index];
+}
+
+int8_t adc_configure_injected_trigger_source(uint8_t adc_number, adc_ev_src_t trigger_source)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return -1;
+
+	if ( (trigger_source != software) && (trigger_source != hrtim_ev2) && (trigger_source != hrtim_ev4) )
+		return -1;
+
+	adc_injected_trigger_sources[adc_number-1] = trigger_source;
+
+	return 0;
+}
+
+uint32_t adc_get_injected_channels_count(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return 0;
+
+	return injected_channels_count[adc_number-1];
+}
+
+volatile uint32_t* adc_get_injected_data_register(uint8_t adc_number, uint8_t rank)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return NULL;
+
+	if ( (rank == 0) || (rank > injected_channels_count[adc_number-1]) )
+		return NULL;
+
+	return adc_core_get_injected_data_register(adc_number, rank);
+}
+
+int8_t adc_configure_oversampling(uint8_t adc_number, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return -1;
+
+	// Ratio must be a power of two up to 256
+	if ( (ratio == 0) || (ratio > 256) || ((ratio & (ratio-1)) != 0) )
+		return -1;
+
+	uint32_t ratio_bits = 0;
+	while ((1U << ratio_bits) < ratio)
+	{
+		ratio_bits++;
+	}
+
+	// Do not shift below native resolution, and
+	// make sure values still fit in 16 bits.
+	if ( (shift > ratio_bits) || (ratio_bits - shift > 4) )
+		return -1;
+
+	uint8_t adc_index = adc_number-1;
+
+	oversampling_ratio[adc_index] = ratio;
+	oversampling_shift[adc_index] = shift;
+	oversampling_mode[adc_index]  = mode;
+
+	return 0;
+}
+
+uint8_t adc_get_oversampling_extra_bits(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return 0;
+
+	uint8_t adc_index = adc_number-1;
+
+	uint32_t ratio_bits = 0;
+	while ((1U << ratio_bits) < oversampling_ratio[adc_index])
+	{
+		ratio_bits++;
+	}
+
+	return ratio_bits - oversampling_shift[adc_index];
+}
+
+uint32_t adc_get_oversampling_ratio(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return 1;
+
+	return oversampling_ratio[adc_number-1];
+}
+
+adc_ovs_mode_t adc_get_oversampling_mode(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return ovs_continuous;
+
+	return oversampling_mode[adc_number-1];
+}
+
+adc_ev_src_t adc_get_trigger_source(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return software;
+
+	return adc_trigger_sources[adc_number-1];
+}
+
+uint32_t adc_get_discontinuous_mode(uint8_t adc_number)
+{
+	if ( (adc_number == 0) || (adc_number > NUMBER_OF_ADCS) )
+		return 0;
+
+	return adc_discontinuous_mode[adc_number-1];
+}
+
+void adc_configure_dual_mode(bool enable_dual_mode)
+{
+	dual_mode = enable_dual_mode;
+}
+
+bool adc_get_dual_mode()
+{
+	if (dual_mode == false)
+		return false;
+
+	// Simultaneous conversion requires sequences of the same length
+	return (enabled_channels_count[0] > 0) && (enabled_channels_count[0] == enabled_channels_count[1]);
+}
+
 void adc_start()
 {
 	/////
@@ -138,12 +300,14 @@ void adc_start()
 	/////
 	// Pre-enable configuration
 
-	// Nothing here for now.
-
 	// If some channels have to be set as differential,
-	// or ADCs have to be set as dual mode,
 	// this shoud be done here.
 
+	// In dual mode, packed results are transferred using
+	// ADC 1 DMA request, per-ADC DMA being disabled.
+	bool use_dual_mode = adc_get_dual_mode();
+	adc_core_configure_dual_mode(use_dual_mode, enable_dma[0]);
+
 	/////
 	// Enable ADCs
 
@@ -175,7 +339,13 @@ void adc_start()
 		uint8_t adc_index = adc_num-1;
 		if (enabled_channels_count[adc_index] > 0)
 		{
-			adc_core_configure_dma_mode(adc_num, enable_dma[adc_index]);
+			bool use_dma = enable_dma[adc_index];
+			if ( (use_dual_mode == true) && (adc_num <= 2) )
+			{
+				use_dma = false;
+			}
+
+			adc_core_configure_dma_mode(adc_num, use_dma);
 		}
 	}
 
@@ -188,6 +358,18 @@ void adc_start()
 		}
 	}
 
+	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
+	{
+		uint8_t adc_index = adc_num-1;
+		if (enabled_channels_count[adc_index] > 0)
+		{
+			adc_core_configure_oversampling(adc_num,
+			                                oversampling_ratio[adc_index],
+			                                oversampling_shift[adc_index],
+			                                oversampling_mode[adc_index] == ovs_triggered);
+		}
+	}
+
 	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
 	{
 		uint8_t adc_index = adc_num-1;
@@ -215,21 +397,70 @@ void adc_start()
 				break;
 			}
 
+			// Slave ADC is triggered by master
+			if (_adc_is_dual_slave(adc_num) == true)
+			{
+				trig = LL_ADC_REG_TRIG_SOFTWARE;
+			}
+
 			adc_core_configure_trigger_source(adc_num, LL_ADC_REG_TRIG_EXT_RISING, trig);
 		}
 	}
 
+	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
+	{
+		uint8_t adc_index = adc_num-1;
+		if (injected_channels_count[adc_index] > 0)
+		{
+			// Convert to LL constants
+			uint32_t trig;
+			switch (adc_injected_trigger_sources[adc_index])
+			{
+			case hrtim_ev2:
+				trig = LL_ADC_INJ_TRIG_EXT_HRTIM_TRG2;
+				break;
+			case hrtim_ev4:
+				trig = LL_ADC_INJ_TRIG_EXT_HRTIM_TRG4;
+				break;
+			case software:
+			default:
+				trig = LL_ADC_INJ_TRIG_SOFTWARE;
+				break;
+			}
+
+			adc_core_configure_injected_sequence(adc_num,
+			                                     LL_ADC_INJ_TRIG_EXT_RISING,
+			                                     trig,
+			                                     injected_channels_count[adc_index],
+			                                     injected_channels[adc_index]);
+		}
+	}
+
 	/////
 	// Start ADCs
 
 	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
 	{
 		uint8_t adc_index = adc_num-1;
-		if ( (enabled_channels_count[adc_index] > 0) && (adc_trigger_sources[adc_index] != software) )
+		if (_adc_is_dual_slave(adc_num) == true)
+		{
+			// Slave sequence is started along with master sequence
+			adc_core_set_sequence_length(adc_num, enabled_channels_count[adc_index]);
+		}
+		else if ( (enabled_channels_count[adc_index] > 0) && (adc_trigger_sources[adc_index] != software) )
 		{
 			adc_core_start(adc_num, enabled_channels_count[adc_index]);
 		}
 	}
+
+	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
+	{
+		uint8_t adc_index = adc_num-1;
+		if ( (injected_channels_count[adc_index] > 0) && (adc_injected_trigger_sources[adc_index] != software) )
+		{
+			adc_core_start_injected(adc_num);
+		}
+	}
 }
 
 void adc_stop()
@@ -237,10 +468,16 @@ void adc_stop()
 	for (uint8_t adc_num = 1 ; adc_num <= NUMBER_OF_ADCS ; adc_num++)
 	{
 		uint8_t adc_index = adc_num-1;
-		if ( (enabled_channels_count[adc_index] > 0) && (adc_trigger_sources[adc_index] != software) )
+		if ( (enabled_channels_count[adc_index] > 0) && (adc_trigger_sources[adc_index] != software) &&
+		     (_adc_is_dual_slave(adc_num) == false) )
 		{
 			adc_core_stop(adc_num);
 		}
+
+		if ( (injected_channels_count[adc_index] > 0) && (adc_injected_trigger_sources[adc_index] != software) )
+		{
+			adc_core_stop_injected(adc_num);
+		}
 	}
 }
 
@@ -248,3 +485,8 @@ void adc_trigger_software_conversion(uint8_t adc_number, uint8_t number_of_acqui
 {
 	adc_core_start(adc_number, number_of_acquisitions);
 }
+
+void adc_trigger_software_injected_conversion(uint8_t adc_number)
+{
+	adc_core_start_injected(adc_number);
+}
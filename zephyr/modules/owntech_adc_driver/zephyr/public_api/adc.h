@@ -60,6 +60,12 @@ typedef enum
 	hrtim_ev4 = 4,
 } adc_ev_src_t;
 
+typedef enum
+{
+	ovs_continuous = 0,
+	ovs_triggered  = 1,
+} adc_ovs_mode_t;
+
 
 /////
 // Public API
@@ -141,6 +147,170 @@ uint32_t adc_get_enabled_channels_count(uint8_t adc_number);
  */
 void adc_configure_use_dma(uint8_t adc_number, bool use_dma);
 
+/**
+ * @brief Adds a channel to the injected sequence of an ADC.
+ *        Injected conversions interrupt the regular sequence
+ *        and their results are held in dedicated registers,
+ *        without going through DMA.
+ *        Up to 4 channels can be added to the injected sequence.
+ *
+ *        This will only be applied when ADC is started.
+ *        If ADC is already started, it must be stopped
+ *        then started again.
+ *
+ * @param adc_number Number of the ADC to configure.
+ * @param channel Number of the channel to to be acquired.
+ * @return Rank of the channel in the injected sequence,
+ *         or -1 if the sequence is full.
+ */
+int8_t adc_add_injected_channel(uint8_t adc_number, uint8_t channel);
+
+/**
+ * @brief Registers the trigger source for the injected
+ *        sequence of an ADC. Injected sequence can only be
+ *        triggered by HRTIM ADC triggers 2 and 4.
+ *
+ *        This will only be applied when ADC is started.
+ *        If ADC is already started, it must be stopped
+ *        then started again.
+ *
+ * @param adc_number Number of the ADC to configure.
+ * @param trigger_source Source of the trigger: hrtim_ev2,
+ *        hrtim_ev4 or software (default).
+ * @return 0 if trigger source is valid, -1 otherwise.
+ */
+int8_t adc_configure_injected_trigger_source(uint8_t adc_number, adc_ev_src_t trigger_source);
+
+/**
+ * @brief  Returns the number of channels in the injected
+ *         sequence of an ADC.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Number of injected channels on the given ADC.
+ */
+uint32_t adc_get_injected_channels_count(uint8_t adc_number);
+
+/**
+ * @brief  Returns the address of the data register holding
+ *         the latest injected conversion result for a rank.
+ *         Reading this register has no side effect.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  rank Rank in the injected sequence, from 1 to 4.
+ * @return Address of the register, or NULL if parameters are invalid.
+ */
+volatile uint32_t* adc_get_injected_data_register(uint8_t adc_number, uint8_t rank);
+
+/**
+ * @brief This function triggers a conversion of the injected
+ *        sequence in the case of a software triggered sequence.
+ *
+ *        This function must only be called after
+ *        ADC has been started.
+ *
+ * @param  adc_number Number of the ADC.
+ */
+void adc_trigger_software_injected_conversion(uint8_t adc_number);
+
+/**
+ * @brief Registers the hardware oversampling configuration
+ *        for an ADC. Each regular conversion is then replaced
+ *        by the sum of ratio conversions, right-shifted by shift.
+ *        Resulting values have 12 + log2(ratio) - shift bits.
+ *
+ *        This will only be applied when ADC is started.
+ *        If ADC is already started, it must be stopped
+ *        then started again.
+ *
+ * @param adc_number Number of the ADC to configure.
+ * @param ratio Oversampling ratio: power of two from 2 to 256,
+ *        or 1 to disable oversampling (default).
+ * @param shift Right shift applied to the result. It must not
+ *        exceed log2(ratio), and resulting values must fit
+ *        in 16 bits.
+ * @param mode ovs_continuous to acquire the whole oversampled
+ *        burst on a single trigger, ovs_triggered to require
+ *        a trigger for each conversion of the burst.
+ * @return 0 if configuration is valid, -1 otherwise.
+ */
+int8_t adc_configure_oversampling(uint8_t adc_number, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode);
+
+/**
+ * @brief  Returns the number of additional bits of
+ *         the values of an ADC due to oversampling,
+ *         i.e. log2(ratio) - shift.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Number of additional bits, 0 if oversampling is disabled.
+ */
+uint8_t adc_get_oversampling_extra_bits(uint8_t adc_number);
+
+/**
+ * @brief  Returns the oversampling ratio of an ADC.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Oversampling ratio, 1 if oversampling is disabled.
+ */
+uint32_t adc_get_oversampling_ratio(uint8_t adc_number);
+
+/**
+ * @brief  Returns the oversampling mode of an ADC.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Oversampling mode.
+ */
+adc_ovs_mode_t adc_get_oversampling_mode(uint8_t adc_number);
+
+/**
+ * @brief  Returns the registered trigger source of an ADC.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Trigger source.
+ */
+adc_ev_src_t adc_get_trigger_source(uint8_t adc_number);
+
+/**
+ * @brief  Returns the registered discontinuous count of an ADC.
+ *
+ * @param  adc_number Number of the ADC to fetch.
+ * @return Discontinuous count, 0 if discontinuous mode is disabled.
+ */
+uint32_t adc_get_discontinuous_mode(uint8_t adc_number);
+
+
+/**
+ * @brief Registers the dual mode configuration of ADC 1 and ADC 2.
+ *        In dual regular simultaneous mode, ADC 2 sequence is
+ *        converted at the same instant as ADC 1 sequence, on
+ *        ADC 1 trigger: ADC 2 trigger source is ignored. Values
+ *        of the same rank on both ADCs thus form simultaneous pairs.
+ *        When DMA is used, pairs are transferred by a single 32-bit
+ *        DMA stream on ADC 1 DMA request, ADC 1 value in the low
+ *        half-word and ADC 2 value in the high half-word.
+ *
+ *        Dual mode is only applied if both ADCs have the same
+ *        number of enabled channels when ADCs are started.
+ *        Otherwise, ADCs remain independent.
+ *
+ *        This will only be applied when ADC is started.
+ *        If ADC is already started, it must be stopped
+ *        then started again.
+ *
+ * @param enable_dual_mode Set to true to enable dual mode,
+ *        false for independent ADCs (default).
+ */
+void adc_configure_dual_mode(bool enable_dual_mode);
+
+/**
+ * @brief  Returns whether ADC 1 and ADC 2 are (or will be when
+ *         started) operated in dual regular simultaneous mode,
+ *         i.e. dual mode is enabled and both ADCs have the same
+ *         number of enabled channels.
+ *
+ * @return true if dual mode is effective, false otherwise.
+ */
+bool adc_get_dual_mode();
+
 
 /**
  * @brief Starts all configured ADCs.
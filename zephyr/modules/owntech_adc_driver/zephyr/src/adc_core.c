@@ -199,6 +199,13 @@ void adc_core_stop(uint8_t adc_num)
 	LL_ADC_REG_StopConversion(adc);
 }
 
+void adc_core_set_sequence_length(uint8_t adc_num, uint8_t sequence_length)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	LL_ADC_REG_SetSequencerLength(adc, sequence_length - 1);
+}
+
 void adc_core_configure_dma_mode(uint8_t adc_num, bool use_dma)
 {
 	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
@@ -213,6 +220,29 @@ void adc_core_configure_dma_mode(uint8_t adc_num, bool use_dma)
 	}
 }
 
+void adc_core_configure_dual_mode(bool enable_dual_mode, bool use_dma)
+{
+	if (enable_dual_mode == true)
+	{
+		LL_ADC_SetMultimode(ADC12_COMMON, LL_ADC_MULTI_DUAL_REG_SIMULT);
+
+		// Pack both 16-bit results in a single 32-bit DMA transfer
+		if (use_dma == true)
+		{
+			LL_ADC_SetMultiDMATransfer(ADC12_COMMON, LL_ADC_MULTI_REG_DMA_UNLMT_RES12_10B);
+		}
+		else
+		{
+			LL_ADC_SetMultiDMATransfer(ADC12_COMMON, LL_ADC_MULTI_REG_DMA_EACH_ADC);
+		}
+	}
+	else
+	{
+		LL_ADC_SetMultimode(ADC12_COMMON, LL_ADC_MULTI_INDEPENDENT);
+		LL_ADC_SetMultiDMATransfer(ADC12_COMMON, LL_ADC_MULTI_REG_DMA_EACH_ADC);
+	}
+}
+
 void adc_core_configure_trigger_source(uint8_t adc_num, uint32_t external_trigger_edge, uint32_t trigger_source)
 {
 	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
@@ -334,6 +364,155 @@ void adc_core_configure_channel(uint8_t adc_num, uint8_t channel, uint8_t rank)
 	LL_ADC_SetChannelSamplingTime(adc, ll_channel, LL_ADC_SAMPLINGTIME_12CYCLES_5);
 }
 
+void adc_core_configure_injected_sequence(uint8_t adc_num, uint32_t external_trigger_edge, uint32_t trigger_source, uint8_t sequence_length, const uint8_t* channels)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	uint32_t ll_channels[4] = {0};
+	for (uint8_t rank = 0 ; rank < sequence_length ; rank++)
+	{
+		ll_channels[rank] = __LL_ADC_DECIMAL_NB_TO_CHANNEL(channels[rank]);
+		LL_ADC_SetChannelSamplingTime(adc, ll_channels[rank], LL_ADC_SAMPLINGTIME_12CYCLES_5);
+	}
+
+	uint32_t ll_length;
+	switch (sequence_length)
+	{
+		case 2:
+			ll_length = LL_ADC_INJ_SEQ_SCAN_ENABLE_2RANKS;
+			break;
+		case 3:
+			ll_length = LL_ADC_INJ_SEQ_SCAN_ENABLE_3RANKS;
+			break;
+		case 4:
+			ll_length = LL_ADC_INJ_SEQ_SCAN_ENABLE_4RANKS;
+			break;
+		default:
+			ll_length = LL_ADC_INJ_SEQ_SCAN_DISABLE;
+	}
+
+	// Injected sequence and trigger are held in a single
+	// register (JSQR), which must be written at once.
+	LL_ADC_INJ_ConfigQueueContext(adc,
+	                              trigger_source,
+	                              external_trigger_edge,
+	                              ll_length,
+	                              ll_channels[0],
+	                              ll_channels[1],
+	                              ll_channels[2],
+	                              ll_channels[3]);
+}
+
+void adc_core_start_injected(uint8_t adc_num)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	LL_ADC_INJ_StartConversion(adc);
+}
+
+void adc_core_stop_injected(uint8_t adc_num)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	LL_ADC_INJ_StopConversion(adc);
+}
+
+volatile uint32_t* adc_core_get_injected_data_register(uint8_t adc_num, uint8_t rank)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	switch (rank)
+	{
+		case 1:
+			return &adc->JDR1;
+		case 2:
+			return &adc->JDR2;
+		case 3:
+			return &adc->JDR3;
+		case 4:
+			return &adc->JDR4;
+		default:
+			return NULL;
+	}
+}
+
+void adc_core_configure_oversampling(uint8_t adc_num, uint32_t ratio, uint32_t shift, bool triggered)
+{
+	ADC_TypeDef* adc = _get_adc_by_number(adc_num);
+
+	uint32_t ll_ratio;
+	switch (ratio)
+	{
+		case 2:
+			ll_ratio = LL_ADC_OVS_RATIO_2;
+			break;
+		case 4:
+			ll_ratio = LL_ADC_OVS_RATIO_4;
+			break;
+		case 8:
+			ll_ratio = LL_ADC_OVS_RATIO_8;
+			break;
+		case 16:
+			ll_ratio = LL_ADC_OVS_RATIO_16;
+			break;
+		case 32:
+			ll_ratio = LL_ADC_OVS_RATIO_32;
+			break;
+		case 64:
+			ll_ratio = LL_ADC_OVS_RATIO_64;
+			break;
+		case 128:
+			ll_ratio = LL_ADC_OVS_RATIO_128;
+			break;
+		case 256:
+			ll_ratio = LL_ADC_OVS_RATIO_256;
+			break;
+		default:
+			// Ratio 1 or invalid ratio: disable oversampling
+			LL_ADC_SetOverSamplingScope(adc, LL_ADC_OVS_DISABLE);
+			return;
+	}
+
+	uint32_t ll_shift;
+	switch (shift)
+	{
+		case 1:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_1;
+			break;
+		case 2:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_2;
+			break;
+		case 3:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_3;
+			break;
+		case 4:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_4;
+			break;
+		case 5:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_5;
+			break;
+		case 6:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_6;
+			break;
+		case 7:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_7;
+			break;
+		case 8:
+			ll_shift = LL_ADC_OVS_SHIFT_RIGHT_8;
+			break;
+		default:
+			ll_shift = LL_ADC_OVS_SHIFT_NONE;
+	}
+
+	uint32_t ll_discont = (triggered == true) ? LL_ADC_OVS_REG_DISCONT : LL_ADC_OVS_REG_CONT;
+
+	// Oversampling is only applied to regular group,
+	// injected conversions are not interrupted.
+	LL_ADC_SetOverSamplingScope(adc, LL_ADC_OVS_GRP_REGULAR_CONTINUED);
+	LL_ADC_SetOverSamplingDiscont(adc, ll_discont);
+	LL_ADC_ConfigOverSamplingRatioShift(adc, ll_ratio, ll_shift);
+}
+
 void adc_core_init()
 {
 	static bool initialized = false;
@@ -71,6 +71,18 @@ void adc_core_start(uint8_t adc_num, uint8_t sequence_length);
  */
 void adc_core_stop(uint8_t adc_num);
 
+/**
+ * @brief Set the length of the regular sequence of an ADC
+ *        without starting it. This is required for the
+ *        slave ADC in dual mode, which is started by
+ *        the master ADC.
+ *
+ * @param adc_num Number of the ADC to configure.
+ * @param sequence_length Length of the sequence configured
+ *        on that ADC.
+ */
+void adc_core_set_sequence_length(uint8_t adc_num, uint8_t sequence_length);
+
 
 /////
 // Configuration functions
@@ -85,6 +97,25 @@ void adc_core_stop(uint8_t adc_num);
  */
 void adc_core_configure_dma_mode(uint8_t adc_num, bool use_dma);
 
+/**
+ * @brief ADC 1/2 dual mode configuration.
+ *        In dual regular simultaneous mode, ADC 1 (master)
+ *        and ADC 2 (slave) convert their regular sequences
+ *        simultaneously on master trigger. Results are packed
+ *        in the common data register, master result in the
+ *        low half-word and slave result in the high half-word,
+ *        and are transferred by a single DMA request.
+ *        Refer to RM 21.4.31
+ *
+ * @note  This must be done while ADC 1 and ADC 2 are disabled.
+ *
+ * @param enable_dual_mode Set to true to enable dual regular
+ *        simultaneous mode, false for independent mode (default).
+ * @param use_dma Set to true to transfer packed results using DMA.
+ *        Ignored in independent mode.
+ */
+void adc_core_configure_dual_mode(bool enable_dual_mode, bool use_dma);
+
 /**
  * @brief Defines the trigger source for an ADC.
  *
@@ -130,6 +161,61 @@ void adc_core_set_channel_differential(uint8_t adc_num, uint8_t channel, bool en
  */
 void adc_core_configure_channel(uint8_t adc_num, uint8_t channel, uint8_t rank);
 
+/**
+ * @brief Configures the injected sequence of an ADC.
+ *        Channels sampling time is set to 12.5 cycles.
+ *        Refer to RM 21.4.21
+ *
+ * @param adc_num Number of the ADC to configure.
+ * @param external_trigger_edge Edge of the trigger as defined
+ *        in stm32gxx_ll_adc.h (LL_ADC_INJ_TRIG_***).
+ * @param trigger_source Source of the trigger as defined
+ *        in stm32gxx_ll_adc.h (LL_ADC_INJ_TRIG_***).
+ * @param sequence_length Length of the injected sequence, from 1 to 4.
+ * @param channels Array of sequence_length channel numbers,
+ *        in acquisition order.
+ */
+void adc_core_configure_injected_sequence(uint8_t adc_num, uint32_t external_trigger_edge, uint32_t trigger_source, uint8_t sequence_length, const uint8_t* channels);
+
+/**
+ * @brief ADC injected conversions start. With an external
+ *        trigger, this arms the injected sequence.
+ *
+ * @param adc_num Number of the ADC to start.
+ */
+void adc_core_start_injected(uint8_t adc_num);
+
+/**
+ * @brief ADC injected conversions stop.
+ *
+ * @param adc_num Number of the ADC to stop.
+ */
+void adc_core_stop_injected(uint8_t adc_num);
+
+/**
+ * @brief Get the address of an injected data register (JDRx),
+ *        so that it can be read directly.
+ *
+ * @param adc_num Number of the ADC.
+ * @param rank Rank in the injected sequence, from 1 to 4.
+ * @return Address of the register, or NULL if rank is invalid.
+ */
+volatile uint32_t* adc_core_get_injected_data_register(uint8_t adc_num, uint8_t rank);
+
+/**
+ * @brief Configures the hardware oversampler of an ADC for
+ *        regular conversions. Refer to RM 21.4.30
+ *
+ * @param adc_num Number of the ADC to configure.
+ * @param ratio Oversampling ratio: power of two from 2 to 256,
+ *        or 1 to disable oversampling (default).
+ * @param shift Right shift applied to the accumulated result, from 0 to 8.
+ * @param triggered Set to true to require a trigger for each
+ *        conversion of the oversampled burst, false to convert
+ *        the whole burst on a single trigger (default).
+ */
+void adc_core_configure_oversampling(uint8_t adc_num, uint32_t ratio, uint32_t shift, bool triggered);
+
 
 #ifdef __cplusplus
 }
@@ -46,12 +46,20 @@ uint16_t CanCommunication::getCanNodeAddr()
 
 bool CanCommunication::getCtrlEnable()
 {
-    return ctrl_enable;
+    return can_control_params.read().enable;
 }
 
 float32_t CanCommunication::getCtrlReference()
 {
-    return reference_value;
+    return can_control_params.read().reference;
+}
+
+void CanCommunication::getCtrlParams(bool& enable, float32_t& reference)
+{
+    can_control_params_t params = can_control_params.read();
+
+    enable    = params.enable;
+    reference = params.reference;
 }
 
 uint16_t CanCommunication::getBroadcastPeriod()
@@ -72,12 +80,23 @@ void CanCommunication::setCanNodeAddr(uint16_t addr)
 
 void CanCommunication::setCtrlEnable(bool enable)
 {
-    ctrl_enable = enable;
+    can_control_params.modify([=](can_control_params_t& params)
+    {
+        params.enable = enable;
+    });
 }
 
 void CanCommunication::setCtrlReference(float32_t reference)
 {
-    reference_value = reference;
+    can_control_params.modify([=](can_control_params_t& params)
+    {
+        params.reference = reference;
+    });
+}
+
+void CanCommunication::setCtrlParams(bool enable, float32_t reference)
+{
+    can_control_params.write({reference, enable});
 }
 
 void CanCommunication::setBroadcastPeriod(uint16_t time_100_ms)
@@ -61,6 +61,19 @@ public:
 	 */
 	static float32_t getCtrlReference();
 
+	/**
+	 * @brief Get both control parameters at once. Use this
+	 *        function rather than getCtrlEnable() then
+	 *        getCtrlReference() to get values consistent with
+	 *        each other, as they can be modified in between.
+	 *        This function never blocks and can be called
+	 *        from the critical task.
+	 *
+	 * @param enable Variable to store the control enable status.
+	 * @param reference Variable to store the control reference value.
+	 */
+	static void getCtrlParams(bool& enable, float32_t& reference);
+
 	/**
 	 * @brief Get the broadcast period.
 	 *
@@ -96,6 +109,16 @@ public:
 	 */
 	static void setCtrlReference(float32_t reference);
 
+	/**
+	 * @brief Set both control parameters at once, so that
+	 *        the critical task never sees one updated without
+	 *        the other.
+	 *
+	 * @param enable True to enable control, false to disable it.
+	 * @param reference The control reference value to set.
+	 */
+	static void setCtrlParams(bool enable, float32_t reference);
+
 	/**
 	 * @brief Set the broadcast period.
 	 *
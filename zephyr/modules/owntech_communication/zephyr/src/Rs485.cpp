@@ -29,9 +29,16 @@
 #include <stm32_ll_bus.h>
 
 /* Zephyr drivers */
+#include <zephyr/init.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/drivers/dma.h>
 
+/* OwnTech DMA channels allocator */
+#include "dma_channels.h"
+
+/* OwnTech shared parameters */
+#include "SharedParams.h"
+
 /* Header */
 #include "Rs485.h"
 
@@ -58,20 +65,40 @@ static const struct device *dma1 = DEVICE_DT_GET(DT_NODELABEL(dma1));
 static const struct device *uart_dev = DEVICE_DT_GET(DT_NODELABEL(usart3));
 
 /* USART initialization parameters */
-static uint32_t baud = 21250000 / (2); /* initial baudrate to  10.625Mhz */
 struct uart_config uart_cfg;
 struct uart_event evt;
 
-/* DMA buffer for transmission and reception */
-static uint8_t* tx_usart_val;
-static uint8_t* rx_usart_val;
-
-static uint16_t dma_buffer_size;
+/* User configuration, read by the critical task and the RX callback */
+typedef struct
+{
+    uint32_t baud;                 // baudrate
+    uint8_t* tx_usart_val;         // DMA buffer for transmission
+    uint8_t* rx_usart_val;         // DMA buffer for reception
+    uint16_t dma_buffer_size;      // size of data in bytes
+    dma_callbackRXfunc_t user_fnc; // user function to call in RX callback
+} rs485_config_t;
 
-static dma_callbackRXfunc_t user_fnc = NULL; // user function to call in RX callback
+static SharedParams<rs485_config_t> rs485_config({21250000 / (2), NULL, NULL, 0, NULL}); /* initial baudrate to  10.625Mhz */
 
 //// Private functions
 
+/**
+ * Reserve the DMA channels used by RS485 at boot, before any
+ * other module allocates DMA channels.
+*/
+static int _rs485_reserve_dma_channels()
+{
+    dma_channels_reserve(ZEPHYR_DMA_CHANNEL_TX);
+    dma_channels_reserve(ZEPHYR_DMA_CHANNEL_RX);
+
+    return 0;
+}
+
+SYS_INIT(_rs485_reserve_dma_channels,
+         POST_KERNEL,
+         CONFIG_KERNEL_INIT_PRIORITY_DEFAULT
+        );
+
 /**
  * DMA callback TX clear transmission flag, and disabled DMA channel TX.
 */
@@ -91,6 +118,7 @@ static void _dma_callback_rx()
 {
     LL_DMA_ClearFlag_TC7(DMA_USART); // clear transmission complete flag
 
+    dma_callbackRXfunc_t user_fnc = rs485_config.read().user_fnc;
     if(user_fnc != NULL){
         user_fnc();
     }
@@ -103,8 +131,11 @@ static void _dma_callback_rx()
 */
 void init_usrBuffer(uint8_t* tx_buffer, uint8_t* rx_buffer)
 {
-    tx_usart_val = tx_buffer;
-    rx_usart_val = rx_buffer;
+    rs485_config.modify([=](rs485_config_t& config)
+    {
+        config.tx_usart_val = tx_buffer;
+        config.rx_usart_val = rx_buffer;
+    });
 }
 
 /**
@@ -112,7 +143,25 @@ void init_usrBuffer(uint8_t* tx_buffer, uint8_t* rx_buffer)
  */
 void init_usrFunc(dma_callbackRXfunc_t fnc_callback)
 {
-    user_fnc = fnc_callback;
+    rs485_config.modify([=](rs485_config_t& config)
+    {
+        config.user_fnc = fnc_callback;
+    });
+}
+
+/**
+ * Initialize buffers, data size and RX callback at once, so that the
+ * critical task and RX callback never see a partial configuration
+*/
+void init_usrTransfer(uint8_t* tx_buffer, uint8_t* rx_buffer, uint16_t size, dma_callbackRXfunc_t fnc_callback)
+{
+    rs485_config.modify([=](rs485_config_t& config)
+    {
+        config.tx_usart_val    = tx_buffer;
+        config.rx_usart_val    = rx_buffer;
+        config.dma_buffer_size = size;
+        config.user_fnc        = fnc_callback;
+    });
 }
 
 /**
@@ -120,7 +169,10 @@ void init_usrFunc(dma_callbackRXfunc_t fnc_callback)
 */
 void init_usrBaudrate(uint32_t usr_baud)
 {
-    baud = usr_baud;
+    rs485_config.modify([=](rs485_config_t& config)
+    {
+        config.baud = usr_baud;
+    });
 }
 
 /**
@@ -129,7 +181,10 @@ void init_usrBaudrate(uint32_t usr_baud)
 */
 void init_usrDataSize(uint16_t size)
 {
-    dma_buffer_size = size;
+    rs485_config.modify([=](rs485_config_t& config)
+    {
+        config.dma_buffer_size = size;
+    });
 }
 
 /**
@@ -138,7 +193,7 @@ void init_usrDataSize(uint16_t size)
 void serial_init(void)
 {
     uart_config_get(uart_dev, &uart_cfg);
-    uart_cfg.baudrate = baud;
+    uart_cfg.baudrate = rs485_config.read().baud;
     uart_cfg.flow_ctrl = UART_CFG_FLOW_CTRL_NONE;
     uart_cfg.data_bits = UART_CFG_DATA_BITS_8;
     uart_cfg.parity = UART_CFG_PARITY_NONE;
@@ -212,6 +267,8 @@ void oversamp_set(usart_oversampling_t oversampling)
 */
 void dma_channel_init_tx()
 {
+    rs485_config_t config = rs485_config.read();
+
     /*Configure DMA */
     struct dma_config dma_config_s = {0};
     LL_DMA_InitTypeDef DMA_InitStruct = {0};
@@ -222,21 +279,21 @@ void dma_channel_init_tx()
     /* DMA configuration with LL drivers */
     DMA_InitStruct.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
     DMA_InitStruct.PeriphOrM2MSrcAddress = (uint32_t)(&(USART3->TDR));
-    DMA_InitStruct.MemoryOrM2MDstAddress = (uint32_t)(tx_usart_val);
+    DMA_InitStruct.MemoryOrM2MDstAddress = (uint32_t)(config.tx_usart_val);
     DMA_InitStruct.Mode = LL_DMA_MODE_NORMAL;
     DMA_InitStruct.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
     DMA_InitStruct.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
     DMA_InitStruct.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
     DMA_InitStruct.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
     DMA_InitStruct.PeriphRequest = LL_DMAMUX_REQ_USART3_TX;
-    DMA_InitStruct.NbData = dma_buffer_size;
+    DMA_InitStruct.NbData = config.dma_buffer_size;
 
     dma_config(dma1, ZEPHYR_DMA_CHANNEL_TX, &dma_config_s); // Indicates Callback function to zephyr driver
 
     LL_DMA_DisableChannel(DMA_USART, LL_DMA_CHANNEL_TX); // Disabling channel for initial set-up
 
     /* initialize DMA */
-    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_TX, dma_buffer_size); // DMA data size
+    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_TX, config.dma_buffer_size); // DMA data size
     LL_DMA_SetChannelPriorityLevel(DMA_USART, LL_DMA_CHANNEL_TX, LL_DMA_PRIORITY_VERYHIGH); // DMA channel priority
     LL_DMA_Init(DMA_USART, LL_DMA_CHANNEL_TX, &DMA_InitStruct);
 
@@ -255,20 +312,22 @@ void dma_channel_init_tx()
 */
 void dma_channel_init_rx()
 {
+    rs485_config_t config = rs485_config.read();
+
     /* Configure DMA */
     LL_DMA_InitTypeDef DMA_InitStruct = {0};
 
     /* Initialization of DMA */
     DMA_InitStruct.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
     DMA_InitStruct.PeriphOrM2MSrcAddress = (uint32_t)(&(USART3->RDR));
-    DMA_InitStruct.MemoryOrM2MDstAddress = (uint32_t)(rx_usart_val);
+    DMA_InitStruct.MemoryOrM2MDstAddress = (uint32_t)(config.rx_usart_val);
     DMA_InitStruct.Mode = LL_DMA_MODE_CIRCULAR;
     DMA_InitStruct.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
     DMA_InitStruct.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
     DMA_InitStruct.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
     DMA_InitStruct.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
     DMA_InitStruct.PeriphRequest = LL_DMAMUX_REQ_USART3_RX;
-    DMA_InitStruct.NbData = dma_buffer_size;
+    DMA_InitStruct.NbData = config.dma_buffer_size;
 
     IRQ_DIRECT_CONNECT(17, 0, _dma_callback_rx, IRQ_ZERO_LATENCY);
     irq_enable(17);
@@ -276,7 +335,7 @@ void dma_channel_init_rx()
     LL_DMA_DisableChannel(DMA_USART, LL_DMA_CHANNEL_RX); // Disabling channel for initial set-up
 
      /* initialize DMA */
-    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_RX, dma_buffer_size); // DMA data size
+    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_RX, config.dma_buffer_size); // DMA data size
     LL_DMA_SetChannelPriorityLevel(DMA_USART, LL_DMA_CHANNEL_RX, LL_DMA_PRIORITY_VERYHIGH); // DMA channel priority
     LL_DMA_Init(DMA_USART, LL_DMA_CHANNEL_RX, &DMA_InitStruct);
 
@@ -297,13 +356,15 @@ void dma_channel_init_rx()
 */
 void serial_tx_on()
 {
+    rs485_config_t config = rs485_config.read();
+
     LL_DMA_ClearFlag_TC6(DMA_USART); // Making sure the flag is cleared before transmission
 
     LL_DMA_DisableChannel(DMA_USART, LL_DMA_CHANNEL_TX); // disable channel to reload TX buffer
 
     /* reloading TX buffer */
-    LL_DMA_SetMemoryAddress(DMA_USART, LL_DMA_CHANNEL_TX, (uint32_t)(tx_usart_val));
-    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_TX, dma_buffer_size);
+    LL_DMA_SetMemoryAddress(DMA_USART, LL_DMA_CHANNEL_TX, (uint32_t)(config.tx_usart_val));
+    LL_DMA_SetDataLength(DMA_USART, LL_DMA_CHANNEL_TX, config.dma_buffer_size);
 
     LL_DMA_EnableChannel(DMA_USART, LL_DMA_CHANNEL_TX); // re-enable the channel
 }
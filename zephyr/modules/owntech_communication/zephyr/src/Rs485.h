@@ -51,6 +51,20 @@ void init_usrBuffer(uint8_t* tx_buffer, uint8_t* rx_buffer);
 */
 void init_usrFunc(dma_callbackRXfunc_t fnc_callback);
 
+/**
+ * @brief initialize transmission and reception buffers, data size and
+ *        user function at once. Use this function rather than
+ *        init_usrBuffer, init_usrDataSize and init_usrFunc when
+ *        communication may be in use, so that the new configuration
+ *        is seen as a whole by the RX callback and serial_tx_on.
+ *
+ * @param[in] tx_buffer transmission buffer
+ * @param[in] rx_buffer reception buffer
+ * @param[in] size size of the data in byte (max 65535)
+ * @param[in] fnc_callback void function with no parameters, use NULL if there is no function to call
+*/
+void init_usrTransfer(uint8_t* tx_buffer, uint8_t* rx_buffer, uint16_t size, dma_callbackRXfunc_t fnc_callback);
+
 /**
  * @brief initialize baudrate with user choice.
  *
@@ -28,9 +28,7 @@
 
 void Rs485Communication::configure(uint8_t *transmission_bufer, uint8_t *reception_buffer, uint16_t data_size, void (*user_function)(), rs485_speed_t data_speed)
 {
-    init_usrBuffer(transmission_bufer, reception_buffer);
-    init_usrFunc(user_function);
-    init_usrDataSize(data_size);
+    init_usrTransfer(transmission_bufer, reception_buffer, data_size, user_function);
 
     switch(data_speed)
     {
@@ -60,9 +58,7 @@ void Rs485Communication::configure(uint8_t *transmission_bufer, uint8_t *recepti
 
 void Rs485Communication::configureCustom(uint8_t* transmission_bufer, uint8_t* reception_buffer, uint16_t data_size, void (*user_function)(void), uint32_t baudrate, bool oversampling_8)
 {
-    init_usrBuffer(transmission_bufer, reception_buffer);
-    init_usrFunc(user_function);
-    init_usrDataSize(data_size);
+    init_usrTransfer(transmission_bufer, reception_buffer, data_size, user_function);
     init_usrBaudrate(baudrate);
     dma_channel_init_tx();
     dma_channel_init_rx();
@@ -21,6 +21,10 @@
 #include "thingset.h"
 #include "DataAcquisition.h"
 
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+#include "TaskAPI.h"
+#endif
+
 
 // can be used to configure custom data objects in separate file instead
 // (e.g. data_nodes_custom.cpp)
@@ -47,6 +51,22 @@ bool ctrl_enable = false; //store value of the enable (master-slave mode)
 
 uint16_t can_node_addr = 0x60;
 
+// Control parameters read by the critical task
+SharedParams<can_control_params_t> can_control_params({0, false});
+
+// Control parameters as last copied to data objects
+static can_control_params_t control_snapshot = {0, false};
+
+// Serializes access to control data objects and snapshot
+// between ThingSet threads (ISO-TP and pub/sub)
+K_MUTEX_DEFINE(control_mutex);
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+// Critical task execution times, in CPU cycles (app task)
+uint32_t profiling_max_cycles[profiling_stages_count]  = {0};
+uint32_t profiling_mean_cycles[profiling_stages_count] = {0};
+#endif
+
 
 
 void dataObjectsUpdateMeasures()
@@ -62,6 +82,61 @@ void dataObjectsUpdateMeasures()
         // Do not update this value for now, as the measure is not enabled
         //temp_value = peekTemperature();
     }
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+    task_profile_t profile;
+    for (uint8_t stage = 0 ; stage < profiling_stages_count ; stage++)
+    {
+        if (task.getCriticalProfile((profiling_stage_t)stage, profile) == 0)
+        {
+            profiling_max_cycles[stage]  = profile.max_cycles;
+            profiling_mean_cycles[stage] = profile.mean_cycles;
+        }
+    }
+#endif
+}
+
+void dataObjectsLockControl()
+{
+    k_mutex_lock(&control_mutex, K_FOREVER);
+}
+
+void dataObjectsUnlockControl()
+{
+    k_mutex_unlock(&control_mutex);
+}
+
+void dataObjectsUpdateControl()
+{
+    control_snapshot = can_control_params.read();
+    reference_value  = control_snapshot.reference;
+    ctrl_enable      = control_snapshot.enable;
+}
+
+void dataObjectsApplyControl()
+{
+    bool reference_changed = (reference_value != control_snapshot.reference);
+    bool enable_changed    = (ctrl_enable != control_snapshot.enable);
+
+    if ( (reference_changed == false) && (enable_changed == false) )
+        return;
+
+    // Only publish modified values, so that concurrent
+    // modifications from the application are kept.
+    can_control_params.modify([=](can_control_params_t& params)
+    {
+        if (reference_changed == true)
+        {
+            params.reference = reference_value;
+        }
+        if (enable_changed == true)
+        {
+            params.enable = ctrl_enable;
+        }
+    });
+
+    control_snapshot.reference = reference_value;
+    control_snapshot.enable    = ctrl_enable;
 }
 
 /**
@@ -167,6 +242,94 @@ static ThingSetDataObject data_objects[] = {
         TS_ITEM_FLOAT(0x37, "rMeas_temp_degC", &temp_value, 2,
             ID_MEASUREMENTS, TS_ANY_R, SUBSET_CAN),
 
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+
+    TS_GROUP(ID_PROFILING, "Profiling", TS_NO_CALLBACK, ID_ROOT),
+
+        /*{
+            "title": {
+                "en": "Maximum Safety Check Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x40, "rProf_Safety_max_cyc", &profiling_max_cycles[profiling_stage_safety],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Mean Safety Check Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x41, "rProf_Safety_mean_cyc", &profiling_mean_cycles[profiling_stage_safety],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Maximum Data Dispatch Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x42, "rProf_Dispatch_max_cyc", &profiling_max_cycles[profiling_stage_data_dispatch],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Mean Data Dispatch Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x43, "rProf_Dispatch_mean_cyc", &profiling_mean_cycles[profiling_stage_data_dispatch],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Maximum User Critical Task Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x44, "rProf_User_max_cyc", &profiling_max_cycles[profiling_stage_user_task],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Mean User Critical Task Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x45, "rProf_User_mean_cyc", &profiling_mean_cycles[profiling_stage_user_task],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Maximum Critical Sub-Tasks Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x46, "rProf_SubTasks_max_cyc", &profiling_max_cycles[profiling_stage_subtasks],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Mean Critical Sub-Tasks Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x47, "rProf_SubTasks_mean_cyc", &profiling_mean_cycles[profiling_stage_subtasks],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Maximum Critical Task Interrupt Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x48, "rProf_Total_max_cyc", &profiling_max_cycles[profiling_stage_total],
+            ID_PROFILING, TS_ANY_R, 0),
+
+        /*{
+            "title": {
+                "en": "Mean Critical Task Interrupt Execution Time"
+            }
+        }*/
+        TS_ITEM_UINT32(0x49, "rProf_Total_mean_cyc", &profiling_mean_cycles[profiling_stage_total],
+            ID_PROFILING, TS_ANY_R, 0),
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
+
 
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
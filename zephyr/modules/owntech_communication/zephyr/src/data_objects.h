@@ -23,6 +23,8 @@
 
 #include <arm_math.h>
 
+#include "SharedParams.h"
+
 /*
  * Groups / first layer data object IDs
  */
@@ -30,6 +32,7 @@
 #define ID_ROOT         0x00
 #define ID_DEVICE       0x01
 #define ID_MEASUREMENTS 0x08
+#define ID_PROFILING    0x09
 #define ID_PUB          0x100
 #define ID_CTRL         0x8000
 
@@ -40,6 +43,16 @@
 #define SUBSET_CAN  (1U << 1)   // CAN bus
 #define SUBSET_CTRL (1U << 3)   // control data sent and received via CAN
 
+/*
+ * Control parameters, shared with the critical task
+ */
+
+typedef struct
+{
+    float32_t reference;
+    bool      enable;
+} can_control_params_t;
+
 /*
  * Exposed variables
  */
@@ -48,11 +61,34 @@ extern bool      ctrl_enable;
 extern uint16_t  can_node_addr;
 extern float32_t reference_value;
 
+extern SharedParams<can_control_params_t> can_control_params;
+
 /*
  * Modifiers
  */
 
 void dataObjectsUpdateMeasures();
 
+/**
+ * Lock control data objects. Each sequence of
+ * dataObjectsUpdateControl(), ThingSet access and
+ * dataObjectsApplyControl() must be done with lock held,
+ * as data objects are shared by all ThingSet threads.
+ */
+void dataObjectsLockControl();
+void dataObjectsUnlockControl();
+
+/**
+ * Copy shared control parameters to ThingSet data objects.
+ * Call before ThingSet reads or writes control data objects.
+ */
+void dataObjectsUpdateControl();
+
+/**
+ * Publish control data objects modified by ThingSet
+ * to shared control parameters.
+ */
+void dataObjectsApplyControl();
+
 
 #endif // DATA_OBJECTS_H_
@@ -15,6 +15,7 @@
 
 #include <zephyr/canbus/isotp.h>
 #include "thingset.h"
+#include "data_objects.h"
 #include "CommunicationAPI.h"
 
 extern ThingSet ts;
@@ -94,7 +95,11 @@ void can_isotp_thread()
             resp_len = 1;
         }
         else if (req_len > 0 && rem_len == 0) {
+            dataObjectsLockControl();
+            dataObjectsUpdateControl();
             resp_len = ts.process(rx_buffer, req_len, tx_buffer, sizeof(tx_buffer));
+            dataObjectsApplyControl();
+            dataObjectsUnlockControl();
         }
         else {
             tx_buffer[0] = TS_STATUS_INTERNAL_SERVER_ERR;
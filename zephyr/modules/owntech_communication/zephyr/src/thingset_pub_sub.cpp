@@ -108,11 +108,15 @@ void update_ts_data_nodes(struct can_frame rx_frame)
 		buf[4] = data_id;
 		memcpy(&buf[5], rx_frame.data, 8);
 
+		dataObjectsLockControl();
+		dataObjectsUpdateControl();
+
 		// int status = ts.bin_sub(buf, 5 + rx_frame.dlc, TS_WRITE_MASK, SUBSET_CTRL);
         int status = ts.bin_import(buf + 1, 4 + rx_frame.dlc, TS_WRITE_MASK, SUBSET_CTRL);
 		if (status == TS_STATUS_CHANGED) {
-
+			dataObjectsApplyControl();
 		}
+		dataObjectsUnlockControl();
 	}
 }
 
@@ -146,7 +150,10 @@ void can_pubsub_thread()
 
         if (count % control_time == 0) {
             // control objects: every 100 ms
+            dataObjectsLockControl();
+            dataObjectsUpdateControl();
             send_ts_can_pub_message(SUBSET_CTRL);
+            dataObjectsUnlockControl();
         }
 
 		struct can_frame rx_frame;
@@ -34,6 +34,7 @@
 
 // OwnTech Power API
 #include "SpinAPI.h"
+#include "hrtim.h"
 
 // Current module private functions
 #include "../src/data_dispatch.h"
@@ -48,6 +49,14 @@
 DataAPI data;
 
 
+/////
+// Constants
+
+// Duration of a single ADC conversion with default configuration:
+// (12.5 sampling + 12.5 SAR) cycles at 42.5 MHz
+static const uint32_t ADC_CONVERSION_TIME_NS = 589;
+
+
 /////
 // Public functions accessible only when using Twist
 
@@ -55,9 +64,20 @@ DataAPI data;
 
 int8_t DataAPI::enableShieldChannel(uint8_t adc_num, channel_t channel_name)
 {
+	if ( (channel_name == UNDEFINED_CHANNEL) || (channel_name > SHIELD_CHANNELS_COUNT) )
+		return -1;
+
 	shield_channels_enable_adc_channel(adc_num, channel_name);
 	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel_name);
-	return this->enableChannel(channel_info.adc_num, channel_info.channel_num);
+
+	int8_t result = this->enableChannel(channel_info.adc_num, channel_info.channel_num);
+	if (result != 0)
+		return result;
+
+	// Resolve channel handle once and for all
+	this->channel_handles[channel_name] = this->buildChannelHandle(channel_info.adc_num, channel_info.channel_num);
+
+	return 0;
 }
 
 void DataAPI::enableTwistDefaultChannels()
@@ -80,34 +100,227 @@ void DataAPI::enableTwistDefaultChannels()
 	this->enableShieldChannel(2, I_HIGH);
 }
 
+int8_t DataAPI::enableShieldInjectedChannel(uint8_t adc_num, channel_t channel_name)
+{
+	if ( (channel_name == UNDEFINED_CHANNEL) || (channel_name > SHIELD_CHANNELS_COUNT) )
+		return -1;
+
+	shield_channels_enable_adc_channel(adc_num, channel_name);
+	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel_name);
+
+	int8_t result = this->enableInjectedChannel(channel_info.adc_num, channel_info.channel_num);
+	if (result != 0)
+		return result;
+
+	// Resolve data register once and for all
+	this->injected_handles[channel_name] = this->buildInjectedHandle(channel_info.adc_num, channel_info.channel_num);
+
+	return 0;
+}
+
 uint16_t* DataAPI::getRawValues(channel_t channel, uint32_t& number_of_values_acquired)
 {
-	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel);
-	return this->getChannelRawValues(channel_info.adc_num, channel_info.channel_num, number_of_values_acquired);
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelRawValues(channel_handle, number_of_values_acquired);
+}
+
+uint16_t* DataAPI::getRawValues(channel_t channel, uint32_t& number_of_values_acquired, uint8_t cursor)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelRawValues(channel_handle, number_of_values_acquired, cursor);
+}
+
+uint16_t* DataAPI::getRawValuesTimed(channel_t channel, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelRawValuesTimed(channel_handle, number_of_values_acquired, timestamps);
+}
+
+int8_t DataAPI::registerCursor(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->registerChannelCursor(channel_handle);
+}
+
+void DataAPI::releaseCursor(channel_t channel, uint8_t cursor)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	this->releaseChannelCursor(channel_handle, cursor);
 }
 
 float32_t DataAPI::peek(channel_t channel)
 {
-	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel);
-	return this->peekChannel(channel_info.adc_num, channel_info.channel_num);
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->peekChannel(channel_handle);
+}
+
+float32_t DataAPI::getLatest(channel_t channel, uint8_t* dataValid, channel_sequence_t* sequence)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelLatest(channel_handle, dataValid, sequence);
+}
+
+channel_view_t DataAPI::getRawView(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelRawView(channel_handle);
+}
+
+uint32_t DataAPI::getOverrunCount(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelOverrunCount(channel_handle);
+}
+
+uint32_t DataAPI::getOverrunCount(channel_t channel, uint8_t cursor)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelOverrunCount(channel_handle, cursor);
+}
+
+int8_t DataAPI::getSequenceInfo(channel_t channel, channel_sequence_t& sequence)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelSequenceInfo(channel_handle, sequence);
+}
+
+int8_t DataAPI::peekPair(channel_t channel_a, channel_t channel_b, float32_t& value_a, float32_t& value_b)
+{
+	const channel_handle_t& channel_handle_a = this->channel_handles[channel_a];
+	const channel_handle_t& channel_handle_b = this->channel_handles[channel_b];
+	return this->peekChannelPair(channel_handle_a, channel_handle_b, value_a, value_b);
+}
+
+int8_t DataAPI::getPairedRawViews(channel_t channel_a, channel_t channel_b, channel_view_t& view_a, channel_view_t& view_b)
+{
+	const channel_handle_t& channel_handle_a = this->channel_handles[channel_a];
+	const channel_handle_t& channel_handle_b = this->channel_handles[channel_b];
+	return this->getChannelPairRawViews(channel_handle_a, channel_handle_b, view_a, view_b);
+}
+
+int8_t DataAPI::setBoxcarFilter(channel_t channel, uint32_t length)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->setChannelFilter(channel_handle, filter_boxcar, length);
+}
+
+int8_t DataAPI::setCicFilter(channel_t channel, uint8_t order, uint32_t decimation)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->setChannelFilter(channel_handle, filter_cic, order, decimation);
+}
+
+int8_t DataAPI::setIirFilter(channel_t channel, uint8_t shift)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->setChannelFilter(channel_handle, filter_iir, shift);
+}
+
+void DataAPI::disableFilter(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	this->setChannelFilter(channel_handle, filter_none, 0);
+}
+
+float32_t DataAPI::getFiltered(channel_t channel, uint8_t* dataValid)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelFiltered(channel_handle, dataValid);
+}
+
+int8_t DataAPI::setStatsWindow(channel_t channel, uint32_t window_length)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->setChannelStatsWindow(channel_handle, window_length);
 }
 
-float32_t DataAPI::getLatest(channel_t channel, uint8_t* dataValid)
+channel_stats_t DataAPI::getStats(channel_t channel)
 {
-	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel);
-	return this->getChannelLatest(channel_info.adc_num, channel_info.channel_num, dataValid);
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->getChannelStats(channel_handle);
 }
 
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+int8_t DataAPI::addCaptureChannel(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->addChannelToCapture(channel_handle);
+}
+
+int8_t DataAPI::setCaptureLevelTrigger(channel_t channel, float32_t level, capture_trigger_t edge)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->setChannelCaptureLevelTrigger(channel_handle, level, edge);
+}
+#endif
+
 float32_t DataAPI::convert(channel_t channel, uint16_t raw_value)
 {
-	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel);
-	return data_conversion_convert_raw_value(channel_info.adc_num, channel_info.channel_num, raw_value);
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return data_conversion_convert_raw_value(channel_handle.adc_num, channel_handle.channel_num, raw_value);
+}
+
+void DataAPI::convertBuffer(channel_t channel, const uint16_t* raw_values, size_t values_count, float32_t* converted_values)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	data_conversion_convert_raw_buffer(channel_handle.adc_num, channel_handle.channel_num, raw_values, values_count, converted_values);
+}
+
+float32_t DataAPI::convertAverage(channel_t channel, const uint16_t* raw_values, size_t values_count)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return data_conversion_convert_raw_buffer_average(channel_handle.adc_num, channel_handle.channel_num, raw_values, values_count);
 }
 
 void DataAPI::setParameters(channel_t channel, float32_t gain, float32_t offset)
 {
-	channel_info_t channel_info = shield_channels_get_enabled_channel_info(channel);
-	data_conversion_set_conversion_parameters_linear(channel_info.adc_num, channel_info.channel_num, gain, offset);
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	data_conversion_set_conversion_parameters_linear(channel_handle.adc_num, channel_handle.channel_num, gain, offset);
+}
+
+void DataAPI::setPolynomialParameters(channel_t channel, float32_t a0, float32_t a1, float32_t a2, float32_t a3)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	data_conversion_set_conversion_parameters_poly3(channel_handle.adc_num, channel_handle.channel_num, a0, a1, a2, a3);
+}
+
+int8_t DataAPI::setLookupTableParameters(channel_t channel, const float32_t* anchors, uint8_t anchors_count)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	if (channel_handle.rank == 0)
+		return -1;
+
+	return data_conversion_set_conversion_parameters_lut(channel_handle.adc_num, channel_handle.channel_num, anchors, anchors_count);
+}
+
+q15_t DataAPI::convertQ15(channel_t channel, uint16_t raw_value)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return data_conversion_convert_raw_value_q15(channel_handle.adc_num, channel_handle.channel_num, raw_value);
+}
+
+q31_t DataAPI::convertQ31(channel_t channel, uint16_t raw_value)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return data_conversion_convert_raw_value_q31(channel_handle.adc_num, channel_handle.channel_num, raw_value);
+}
+
+q15_t DataAPI::peekQ15(channel_t channel, uint8_t* dataValid)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return this->peekChannelQ15(channel_handle, dataValid);
+}
+
+void DataAPI::setFixedPointFullScale(channel_t channel, float32_t full_scale)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	data_conversion_set_fixed_point_full_scale(channel_handle.adc_num, channel_handle.channel_num, full_scale);
+}
+
+float32_t DataAPI::getFixedPointFullScale(channel_t channel)
+{
+	const channel_handle_t& channel_handle = this->channel_handles[channel];
+	return data_conversion_get_fixed_point_full_scale(channel_handle.adc_num, channel_handle.channel_num);
 }
 
 void DataAPI::setTwistChannelsUserCalibrationFactors()
@@ -115,6 +328,21 @@ void DataAPI::setTwistChannelsUserCalibrationFactors()
 	shield_channels_set_user_acquisition_parameters();
 }
 
+float32_t DataAPI::readInjected(channel_t channel)
+{
+	const injected_handle_t& injected_handle = this->injected_handles[channel];
+	return this->readChannelInjected(injected_handle);
+}
+
+uint16_t DataAPI::readInjectedRaw(channel_t channel)
+{
+	const injected_handle_t& injected_handle = this->injected_handles[channel];
+	if (injected_handle.data_register == nullptr)
+		return 0;
+
+	return (uint16_t)(*injected_handle.data_register);
+}
+
 #endif // CONFIG_SHIELD_TWIST
 
 
@@ -130,27 +358,58 @@ int8_t DataAPI::enableAcquisition(uint8_t adc_num, uint8_t pin_num)
 	return this->enableChannel(adc_num, channel_num);
 }
 
+int8_t DataAPI::enableInjectedAcquisition(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+		return -1;
+
+	return this->enableInjectedChannel(adc_num, channel_num);
+}
+
 int8_t DataAPI::start()
 {
 	if (this->is_started == true)
 		return -1;
 
+	// Dual sampling requires sequences of the same length on ADC 1 and 2
+	if ( (this->dual_sampling == true) && (spin.adc.getDualMode() == false) )
+		return -1;
+
+	// Check oversampling against current PWM configuration
+	for (uint8_t adc_num = 1 ; adc_num <= ADC_COUNT ; adc_num++)
+	{
+		uint32_t ratio = spin.adc.getOversamplingRatio(adc_num);
+		if (this->checkOversamplingTiming(adc_num, ratio, spin.adc.getOversamplingMode(adc_num)) != 0)
+			return -1;
+	}
+
 	// Initialize conversion
 	data_conversion_init();
+	for (uint8_t adc_num = 1 ; adc_num <= ADC_COUNT ; adc_num++)
+	{
+		data_conversion_set_raw_value_resolution(adc_num, spin.adc.getOversamplingExtraBits(adc_num));
+
+		// Injected values are not oversampled, align them
+		// on regular values resolution for conversion.
+		this->injected_raw_shifts[adc_num-1] = spin.adc.getOversamplingExtraBits(adc_num);
+	}
 
 	// Initialize data dispatch
 	switch (this->dispatch_method)
 	{
 		case DispatchMethod_t::on_dma_interrupt:
 			// Dispatch is handled automatically by Data Dispatch on interrupt
-			data_dispatch_init(interrupt, 0);
+			if (data_dispatch_init(interrupt, 0, this->dispatch_copy) != 0)
+				return -1;
 			break;
 		case DispatchMethod_t::externally_triggered:
 			// Dispatch is triggered by an external call
 			if (this->repetition_count_between_dispatches == 0)
 				return -1;
 
-			data_dispatch_init(task, this->repetition_count_between_dispatches);
+			if (data_dispatch_init(task, this->repetition_count_between_dispatches, this->dispatch_copy) != 0)
+				return -1;
 	}
 
 	// Launch ADC conversion
@@ -181,6 +440,150 @@ void DataAPI::setRepetitionsBetweenDispatches(uint32_t repetition)
 	this->repetition_count_between_dispatches = repetition;
 }
 
+void DataAPI::setDispatchCopy(bool enable_copy)
+{
+	this->dispatch_copy = enable_copy;
+}
+
+int8_t DataAPI::configureDualSampling(bool enable_dual_sampling)
+{
+	if (this->is_started == true)
+		return -1;
+
+	this->dual_sampling = enable_dual_sampling;
+	spin.adc.configureDualMode(enable_dual_sampling);
+
+	return 0;
+}
+
+int8_t DataAPI::configureInjectedTrigger(uint8_t adc_num, adc_ev_src_t trigger_source)
+{
+	if (this->is_started == true)
+		return -1;
+
+	return spin.adc.configureInjectedTriggerSource(adc_num, trigger_source);
+}
+
+void DataAPI::triggerInjectedAcquisition(uint8_t adc_num)
+{
+	spin.adc.triggerSoftwareInjectedConversion(adc_num);
+}
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+void DataAPI::clearCaptureChannels()
+{
+	data_capture_clear_channels();
+
+	for (uint8_t capture_index = 0 ; capture_index < CAPTURE_MAX_CHANNELS ; capture_index++)
+	{
+		this->capture_handles[capture_index] = {0, 0, 0};
+	}
+}
+
+int8_t DataAPI::setCaptureTrigger(capture_trigger_t source)
+{
+	if ( (source != capture_trigger_software) && (source != capture_trigger_safety) )
+		return -1;
+
+	return data_capture_set_trigger(source, 0, 0);
+}
+
+int8_t DataAPI::armCapture(uint32_t pre_trigger_count)
+{
+	return data_capture_arm(pre_trigger_count);
+}
+
+void DataAPI::triggerCapture()
+{
+	data_capture_notify_event(capture_trigger_software);
+}
+
+capture_state_t DataAPI::getCaptureState()
+{
+	return data_capture_get_state();
+}
+
+uint32_t DataAPI::getCaptureDepth()
+{
+	return data_capture_get_depth();
+}
+
+uint32_t DataAPI::getCaptureTriggerIndex(uint8_t capture_index)
+{
+	return data_capture_get_trigger_index(capture_index);
+}
+
+size_t DataAPI::readCapture(uint8_t capture_index, uint32_t start, uint16_t* buffer, size_t count)
+{
+	return data_capture_read(capture_index, start, buffer, count);
+}
+
+int8_t DataAPI::printCapture()
+{
+	if (data_capture_get_state() != capture_frozen)
+		return -1;
+
+	uint8_t channels_count = data_capture_get_channels_count();
+
+	// Channels are aligned on trigger, which may not be at the
+	// same index for all channels if history is not full.
+	int32_t first_index = 0;
+	int32_t last_index  = 0;
+	printk("index");
+	for (uint8_t capture_index = 0 ; capture_index < channels_count ; capture_index++)
+	{
+		int32_t trigger_index = data_capture_get_trigger_index(capture_index);
+		int32_t count         = data_capture_get_count(capture_index);
+
+		if (-trigger_index < first_index)
+		{
+			first_index = -trigger_index;
+		}
+		if (count - trigger_index > last_index)
+		{
+			last_index = count - trigger_index;
+		}
+
+		const channel_handle_t& handle = this->capture_handles[capture_index];
+		printk(",adc%u_ch%u", handle.adc_num, handle.channel_num);
+	}
+	printk("\n");
+
+	for (int32_t index = first_index ; index < last_index ; index++)
+	{
+		printk("%d", index);
+		for (uint8_t capture_index = 0 ; capture_index < channels_count ; capture_index++)
+		{
+			int32_t  position = index + (int32_t)data_capture_get_trigger_index(capture_index);
+			uint16_t raw_value;
+			if ( (position >= 0) && (data_capture_read(capture_index, position, &raw_value, 1) == 1) )
+			{
+				const channel_handle_t& handle = this->capture_handles[capture_index];
+				printk(",%f", (double)data_conversion_convert_raw_value(handle.adc_num, handle.channel_num, raw_value));
+			}
+			else
+			{
+				printk(",");
+			}
+		}
+		printk("\n");
+	}
+
+	return 0;
+}
+#endif
+
+int8_t DataAPI::configureOversampling(uint8_t adc_num, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode)
+{
+	if ( (this->is_started == true) || (adc_num == 0) || (adc_num > ADC_COUNT) )
+		return -1;
+
+	if (this->checkOversamplingTiming(adc_num, ratio, mode) != 0)
+		return -1;
+
+	return spin.adc.configureOversampling(adc_num, ratio, shift, mode);
+}
+
 void DataAPI::triggerAcquisition(uint8_t adc_num)
 {
 	uint8_t enabled_channels = spin.adc.getEnabledChannelsCount(adc_num);
@@ -197,47 +600,46 @@ uint16_t* DataAPI::getRawValues(uint8_t adc_num, uint8_t pin_num, uint32_t& numb
 		return nullptr;
 	}
 
-	return this->getChannelRawValues(adc_num, channel_num, number_of_values_acquired);
+	return this->getChannelRawValues(this->buildChannelHandle(adc_num, channel_num), number_of_values_acquired);
 }
 
-float32_t DataAPI::peek(uint8_t adc_num, uint8_t pin_num)
+uint16_t* DataAPI::getRawValues(uint8_t adc_num, uint8_t pin_num, uint32_t& number_of_values_acquired, uint8_t cursor)
 {
 	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
 	if (channel_num == 0)
 	{
-		return NO_VALUE;
+		number_of_values_acquired = 0;
+		return nullptr;
 	}
 
-	return this->peekChannel(adc_num, channel_num);
+	return this->getChannelRawValues(this->buildChannelHandle(adc_num, channel_num), number_of_values_acquired, cursor);
 }
 
-float32_t DataAPI::getLatest(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid)
+uint16_t* DataAPI::getRawValuesTimed(uint8_t adc_num, uint8_t pin_num, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps)
 {
 	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
 	if (channel_num == 0)
 	{
-		if (dataValid != nullptr)
-		{
-			*dataValid = DATA_IS_MISSING;
-		}
-		return NO_VALUE;
+		number_of_values_acquired = 0;
+		timestamps = nullptr;
+		return nullptr;
 	}
 
-	return this->getChannelLatest(adc_num, channel_num, dataValid);
+	return this->getChannelRawValuesTimed(this->buildChannelHandle(adc_num, channel_num), number_of_values_acquired, timestamps);
 }
 
-float32_t DataAPI::convert(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value)
+int8_t DataAPI::registerCursor(uint8_t adc_num, uint8_t pin_num)
 {
 	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
 	if (channel_num == 0)
 	{
-		return 0;
+		return -1;
 	}
 
-	return data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
+	return this->registerChannelCursor(this->buildChannelHandle(adc_num, channel_num));
 }
 
-void DataAPI::setParameters(uint8_t adc_num, uint8_t pin_num, float32_t gain, float32_t offset)
+void DataAPI::releaseCursor(uint8_t adc_num, uint8_t pin_num, uint8_t cursor)
 {
 	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
 	if (channel_num == 0)
@@ -245,32 +647,358 @@ void DataAPI::setParameters(uint8_t adc_num, uint8_t pin_num, float32_t gain, fl
 		return;
 	}
 
-	data_conversion_set_conversion_parameters_linear(adc_num, channel_num, gain, offset);
+	this->releaseChannelCursor(this->buildChannelHandle(adc_num, channel_num), cursor);
 }
 
+channel_view_t DataAPI::getRawView(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return channel_view_t{nullptr, 0, 0, 0, 0};
+	}
 
-/////
-// Private functions
+	return this->getChannelRawView(this->buildChannelHandle(adc_num, channel_num));
+}
 
-int8_t DataAPI::enableChannel(uint8_t adc_num, uint8_t channel_num)
+uint32_t DataAPI::getOverrunCount(uint8_t adc_num, uint8_t pin_num)
 {
-	if (this->is_started == true)
-		return -1;
-
-	if ( (adc_num == 0) || (adc_num > ADC_COUNT) )
-		return -1;
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
 
-	if ( (channel_num == 0) || (channel_num > CHANNELS_PER_ADC) )
-		return -1;
+	return this->getChannelOverrunCount(this->buildChannelHandle(adc_num, channel_num));
+}
 
-	// Enable channel
-	spin.adc.enableDma(adc_num, true);
+uint32_t DataAPI::getOverrunCount(uint8_t adc_num, uint8_t pin_num, uint8_t cursor)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	return this->getChannelOverrunCount(this->buildChannelHandle(adc_num, channel_num), cursor);
+}
+
+int8_t DataAPI::getSequenceInfo(uint8_t adc_num, uint8_t pin_num, channel_sequence_t& sequence)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		sequence = channel_sequence_t{0, 0};
+		return -1;
+	}
+
+	return this->getChannelSequenceInfo(this->buildChannelHandle(adc_num, channel_num), sequence);
+}
+
+int8_t DataAPI::peekPair(uint8_t adc1_pin_num, uint8_t adc2_pin_num, float32_t& adc1_value, float32_t& adc2_value)
+{
+	uint8_t adc1_channel_num = this->getChannelNumber(1, adc1_pin_num);
+	uint8_t adc2_channel_num = this->getChannelNumber(2, adc2_pin_num);
+	if ( (adc1_channel_num == 0) || (adc2_channel_num == 0) )
+	{
+		return -1;
+	}
+
+	return this->peekChannelPair(this->buildChannelHandle(1, adc1_channel_num),
+	                             this->buildChannelHandle(2, adc2_channel_num),
+	                             adc1_value,
+	                             adc2_value);
+}
+
+int8_t DataAPI::getPairedRawViews(uint8_t adc1_pin_num, uint8_t adc2_pin_num, channel_view_t& adc1_view, channel_view_t& adc2_view)
+{
+	uint8_t adc1_channel_num = this->getChannelNumber(1, adc1_pin_num);
+	uint8_t adc2_channel_num = this->getChannelNumber(2, adc2_pin_num);
+	if ( (adc1_channel_num == 0) || (adc2_channel_num == 0) )
+	{
+		adc1_view = channel_view_t{nullptr, 0, 0, 0, 0};
+		adc2_view = channel_view_t{nullptr, 0, 0, 0, 0};
+		return -1;
+	}
+
+	return this->getChannelPairRawViews(this->buildChannelHandle(1, adc1_channel_num),
+	                                    this->buildChannelHandle(2, adc2_channel_num),
+	                                    adc1_view,
+	                                    adc2_view);
+}
+
+int8_t DataAPI::setBoxcarFilter(uint8_t adc_num, uint8_t pin_num, uint32_t length)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->setChannelFilter(this->buildChannelHandle(adc_num, channel_num), filter_boxcar, length);
+}
+
+int8_t DataAPI::setCicFilter(uint8_t adc_num, uint8_t pin_num, uint8_t order, uint32_t decimation)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->setChannelFilter(this->buildChannelHandle(adc_num, channel_num), filter_cic, order, decimation);
+}
+
+int8_t DataAPI::setIirFilter(uint8_t adc_num, uint8_t pin_num, uint8_t shift)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->setChannelFilter(this->buildChannelHandle(adc_num, channel_num), filter_iir, shift);
+}
+
+void DataAPI::disableFilter(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return;
+	}
+
+	this->setChannelFilter(this->buildChannelHandle(adc_num, channel_num), filter_none, 0);
+}
+
+float32_t DataAPI::getFiltered(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		if (dataValid != nullptr)
+		{
+			*dataValid = DATA_IS_MISSING;
+		}
+		return NO_VALUE;
+	}
+
+	return this->getChannelFiltered(this->buildChannelHandle(adc_num, channel_num), dataValid);
+}
+
+int8_t DataAPI::setStatsWindow(uint8_t adc_num, uint8_t pin_num, uint32_t window_length)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->setChannelStatsWindow(this->buildChannelHandle(adc_num, channel_num), window_length);
+}
+
+channel_stats_t DataAPI::getStats(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return channel_stats_t{NO_VALUE, NO_VALUE, NO_VALUE, NO_VALUE, 0, 0};
+	}
+
+	return this->getChannelStats(this->buildChannelHandle(adc_num, channel_num));
+}
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+int8_t DataAPI::addCaptureChannel(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->addChannelToCapture(this->buildChannelHandle(adc_num, channel_num));
+}
+
+int8_t DataAPI::setCaptureLevelTrigger(uint8_t adc_num, uint8_t pin_num, float32_t level, capture_trigger_t edge)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return this->setChannelCaptureLevelTrigger(this->buildChannelHandle(adc_num, channel_num), level, edge);
+}
+#endif
+
+float32_t DataAPI::readInjected(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return NO_VALUE;
+	}
+
+	return this->readChannelInjected(this->buildInjectedHandle(adc_num, channel_num));
+}
+
+uint16_t DataAPI::readInjectedRaw(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	injected_handle_t injected_handle = this->buildInjectedHandle(adc_num, channel_num);
+	if (injected_handle.data_register == nullptr)
+		return 0;
+
+	return (uint16_t)(*injected_handle.data_register);
+}
+
+float32_t DataAPI::convert(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	return data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
+}
+
+void DataAPI::convertBuffer(uint8_t adc_num, uint8_t pin_num, const uint16_t* raw_values, size_t values_count, float32_t* converted_values)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return;
+	}
+
+	data_conversion_convert_raw_buffer(adc_num, channel_num, raw_values, values_count, converted_values);
+}
+
+float32_t DataAPI::convertAverage(uint8_t adc_num, uint8_t pin_num, const uint16_t* raw_values, size_t values_count)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	return data_conversion_convert_raw_buffer_average(adc_num, channel_num, raw_values, values_count);
+}
+
+void DataAPI::setParameters(uint8_t adc_num, uint8_t pin_num, float32_t gain, float32_t offset)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return;
+	}
+
+	data_conversion_set_conversion_parameters_linear(adc_num, channel_num, gain, offset);
+}
+
+void DataAPI::setPolynomialParameters(uint8_t adc_num, uint8_t pin_num, float32_t a0, float32_t a1, float32_t a2, float32_t a3)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return;
+	}
+
+	data_conversion_set_conversion_parameters_poly3(adc_num, channel_num, a0, a1, a2, a3);
+}
+
+int8_t DataAPI::setLookupTableParameters(uint8_t adc_num, uint8_t pin_num, const float32_t* anchors, uint8_t anchors_count)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return -1;
+	}
+
+	return data_conversion_set_conversion_parameters_lut(adc_num, channel_num, anchors, anchors_count);
+}
+
+q15_t DataAPI::convertQ15(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	return data_conversion_convert_raw_value_q15(adc_num, channel_num, raw_value);
+}
+
+q31_t DataAPI::convertQ31(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return 0;
+	}
+
+	return data_conversion_convert_raw_value_q31(adc_num, channel_num, raw_value);
+}
+
+q15_t DataAPI::peekQ15(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		if (dataValid != nullptr)
+		{
+			*dataValid = DATA_IS_MISSING;
+		}
+		return 0;
+	}
+
+	return this->peekChannelQ15(this->buildChannelHandle(adc_num, channel_num), dataValid);
+}
+
+void DataAPI::setFixedPointFullScale(uint8_t adc_num, uint8_t pin_num, float32_t full_scale)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return;
+	}
+
+	data_conversion_set_fixed_point_full_scale(adc_num, channel_num, full_scale);
+}
+
+
+/////
+// Private functions
+
+int8_t DataAPI::enableChannel(uint8_t adc_num, uint8_t channel_num)
+{
+	if (this->is_started == true)
+		return -1;
+
+	if ( (adc_num == 0) || (adc_num > ADC_COUNT) )
+		return -1;
+
+	if ( (channel_num == 0) || (channel_num > CHANNELS_PER_ADC) )
+		return -1;
+
+	// Per-channel buffers are statically sized
+	uint8_t adc_index = adc_num-1;
+	if (this->current_rank[adc_index] >= CONFIG_OWNTECH_DATA_API_MAX_CHANNELS_PER_ADC)
+		return -1;
+
+	// Enable channel
+	spin.adc.enableDma(adc_num, true);
 	spin.adc.enableChannel(adc_num, channel_num);
 
 
 
 	// Remember rank
-	uint8_t adc_index = adc_num-1;
 	uint8_t channel_index = channel_num-1;
 	this->current_rank[adc_index]++;
 	this->channels_ranks[adc_index][channel_index] = this->current_rank[adc_index];
@@ -278,49 +1006,87 @@ int8_t DataAPI::enableChannel(uint8_t adc_num, uint8_t channel_num)
 	return 0;
 }
 
-uint16_t* DataAPI::getChannelRawValues(uint8_t adc_num, uint8_t channel_num, uint32_t& number_of_values_acquired)
+channel_handle_t DataAPI::buildChannelHandle(uint8_t adc_num, uint8_t channel_num)
 {
-	if (this->is_started == false)
+	channel_handle_t handle = {0, 0, 0};
+
+	if ( (adc_num == 0) || (channel_num == 0) )
+		return handle;
+
+	uint8_t channel_rank = this->getChannelRank(adc_num, channel_num);
+	if (channel_rank != 0)
 	{
-		number_of_values_acquired = 0;
-		return nullptr;
+		handle.adc_num     = adc_num;
+		handle.channel_num = channel_num;
+		handle.rank        = channel_rank;
 	}
 
-	uint8_t channel_rank = this->getChannelRank(adc_num, channel_num);
-	if (channel_rank == 0)
+	return handle;
+}
+
+uint16_t* DataAPI::getChannelRawValues(const channel_handle_t& handle, uint32_t& number_of_values_acquired, uint8_t cursor)
+{
+	if ( (this->is_started == false) || (handle.rank == 0) )
 	{
 		number_of_values_acquired = 0;
 		return nullptr;
 	}
 
-	return data_dispatch_get_acquired_values(adc_num, channel_rank, number_of_values_acquired);
+	return data_dispatch_get_acquired_values(handle.adc_num, handle.rank, number_of_values_acquired, cursor);
 }
 
-float32_t DataAPI::peekChannel(uint8_t adc_num, uint8_t channel_num)
+uint16_t* DataAPI::getChannelRawValuesTimed(const channel_handle_t& handle, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps)
 {
-	if (this->is_started == false)
+	if ( (this->is_started == false) || (handle.rank == 0) )
 	{
-		return NO_VALUE;
+		number_of_values_acquired = 0;
+		timestamps = nullptr;
+		return nullptr;
 	}
 
-	uint8_t channel_rank = this->getChannelRank(adc_num, channel_num);
-	if (channel_rank == 0)
+	return data_dispatch_get_acquired_values_timed(handle.adc_num, handle.rank, number_of_values_acquired, timestamps);
+}
+
+int8_t DataAPI::registerChannelCursor(const channel_handle_t& handle)
+{
+	if (handle.rank == 0)
+		return -1;
+
+	return data_dispatch_register_cursor(handle.adc_num, handle.rank);
+}
+
+void DataAPI::releaseChannelCursor(const channel_handle_t& handle, uint8_t cursor)
+{
+	if (handle.rank == 0)
+		return;
+
+	data_dispatch_release_cursor(handle.adc_num, handle.rank, cursor);
+}
+
+float32_t DataAPI::peekChannel(const channel_handle_t& handle)
+{
+	if ( (this->is_started == false) || (handle.rank == 0) )
 	{
 		return NO_VALUE;
 	}
 
-	uint16_t raw_value = data_dispatch_peek_acquired_value(adc_num, channel_rank);
+	uint16_t raw_value = data_dispatch_peek_acquired_value(handle.adc_num, handle.rank);
 	if (raw_value == PEEK_NO_VALUE)
 	{
 		return NO_VALUE;
 	}
 
-	return data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
+	return data_conversion_convert_raw_value(handle.adc_num, handle.channel_num, raw_value);
 }
 
-float32_t DataAPI::getChannelLatest(uint8_t adc_num, uint8_t channel_num, uint8_t* dataValid)
+float32_t DataAPI::getChannelLatest(const channel_handle_t& handle, uint8_t* dataValid, channel_sequence_t* sequence)
 {
-	if (this->is_started == false)
+	if (sequence != nullptr)
+	{
+		this->getChannelSequenceInfo(handle, *sequence);
+	}
+
+	if ( (this->is_started == false) || (handle.rank == 0) )
 	{
 		if (dataValid != nullptr)
 		{
@@ -329,8 +1095,14 @@ float32_t DataAPI::getChannelLatest(uint8_t adc_num, uint8_t channel_num, uint8_
 		return NO_VALUE;
 	}
 
-	uint8_t channel_rank = this->getChannelRank(adc_num, channel_num);
-	if (channel_rank == 0)
+	// Consume the values acquired since previous call, only to know
+	// if new values were dispatched: the latest value is read from
+	// the peek slot, which always holds the newest dispatched value.
+	uint32_t data_count = 0;
+	data_dispatch_get_acquired_values(handle.adc_num, handle.rank, data_count);
+
+	uint16_t raw_value = data_dispatch_peek_acquired_value(handle.adc_num, handle.rank);
+	if (raw_value == PEEK_NO_VALUE)
 	{
 		if (dataValid != nullptr)
 		{
@@ -339,212 +1111,341 @@ float32_t DataAPI::getChannelLatest(uint8_t adc_num, uint8_t channel_num, uint8_
 		return NO_VALUE;
 	}
 
-	uint32_t data_count;
-	uint16_t* buffer = data_dispatch_get_acquired_values(adc_num, channel_rank, data_count);
+	if (dataValid != nullptr)
+	{
+		*dataValid = (data_count > 0) ? DATA_IS_OK : DATA_IS_OLD;
+	}
+
+	return data_conversion_convert_raw_value(handle.adc_num, handle.channel_num, raw_value);
+}
+
+channel_view_t DataAPI::getChannelRawView(const channel_handle_t& handle)
+{
+	if ( (this->is_started == false) || (handle.rank == 0) )
+	{
+		return channel_view_t{nullptr, 0, 0, 0, 0};
+	}
+
+	return data_dispatch_get_channel_view(handle.adc_num, handle.rank);
+}
+
+uint32_t DataAPI::getChannelOverrunCount(const channel_handle_t& handle, uint8_t cursor)
+{
+	if ( (this->is_started == false) || (handle.rank == 0) )
+	{
+		return 0;
+	}
+
+	return data_dispatch_get_overrun_count(handle.adc_num, handle.rank, cursor);
+}
+
+int8_t DataAPI::getChannelSequenceInfo(const channel_handle_t& handle, channel_sequence_t& sequence)
+{
+	sequence = channel_sequence_t{0, 0};
+
+	if ( (this->is_started == false) || (handle.rank == 0) )
+	{
+		return -1;
+	}
+
+	return data_dispatch_get_sequence_info(handle.adc_num, handle.rank, sequence.sequence_number, sequence.age);
+}
+
+int8_t DataAPI::peekChannelPair(const channel_handle_t& handle_a, const channel_handle_t& handle_b, float32_t& value_a, float32_t& value_b)
+{
+	value_a = NO_VALUE;
+	value_b = NO_VALUE;
+
+	if ( (this->is_started == false) || (handle_a.rank == 0) || (handle_a.rank != handle_b.rank) )
+		return -1;
+
+	// Channels can be provided in any order
+	bool swapped = (handle_a.adc_num == 2);
+	const channel_handle_t& adc1_handle = (swapped == true) ? handle_b : handle_a;
+	const channel_handle_t& adc2_handle = (swapped == true) ? handle_a : handle_b;
+	if ( (adc1_handle.adc_num != 1) || (adc2_handle.adc_num != 2) )
+		return -1;
+
+	uint16_t adc1_raw_value;
+	uint16_t adc2_raw_value;
+	if (data_dispatch_peek_acquired_pair(adc1_handle.rank, adc1_raw_value, adc2_raw_value) != 0)
+		return -1;
+
+	float32_t adc1_value = data_conversion_convert_raw_value(1, adc1_handle.channel_num, adc1_raw_value);
+	float32_t adc2_value = data_conversion_convert_raw_value(2, adc2_handle.channel_num, adc2_raw_value);
+
+	value_a = (swapped == true) ? adc2_value : adc1_value;
+	value_b = (swapped == true) ? adc1_value : adc2_value;
+
+	return 0;
+}
+
+int8_t DataAPI::getChannelPairRawViews(const channel_handle_t& handle_a, const channel_handle_t& handle_b, channel_view_t& view_a, channel_view_t& view_b)
+{
+	view_a = channel_view_t{nullptr, 0, 0, 0, 0};
+	view_b = channel_view_t{nullptr, 0, 0, 0, 0};
+
+	if ( (this->is_started == false) || (handle_a.rank == 0) || (handle_a.rank != handle_b.rank) )
+		return -1;
+
+	if ( (handle_a.adc_num == 1) && (handle_b.adc_num == 2) )
+	{
+		return data_dispatch_get_pair_views(handle_a.rank, view_a, view_b);
+	}
+	else if ( (handle_a.adc_num == 2) && (handle_b.adc_num == 1) )
+	{
+		return data_dispatch_get_pair_views(handle_a.rank, view_b, view_a);
+	}
+
+	return -1;
+}
 
-	if (data_count > 0)
+q15_t DataAPI::peekChannelQ15(const channel_handle_t& handle, uint8_t* dataValid)
+{
+	uint16_t raw_value = PEEK_NO_VALUE;
+
+	if ( (this->is_started == true) && (handle.rank != 0) )
+	{
+		raw_value = data_dispatch_peek_acquired_value(handle.adc_num, handle.rank);
+	}
+
+	if (raw_value == PEEK_NO_VALUE)
 	{
-		uint16_t raw_value = buffer[data_count - 1];
 		if (dataValid != nullptr)
 		{
-			*dataValid = DATA_IS_OK;
+			*dataValid = DATA_IS_MISSING;
 		}
-		return data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
+		return 0;
 	}
-	else
+
+	if (dataValid != nullptr)
 	{
-		uint16_t raw_value = data_dispatch_peek_acquired_value(adc_num, channel_rank);
+		*dataValid = DATA_IS_OK;
+	}
+	return data_conversion_convert_raw_value_q15(handle.adc_num, handle.channel_num, raw_value);
+}
 
-		float32_t peekValue;
-		if (raw_value != PEEK_NO_VALUE)
-		{
-			data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
-		}
-		else
-		{
-			peekValue = NO_VALUE;
-		}
+int8_t DataAPI::enableInjectedChannel(uint8_t adc_num, uint8_t channel_num)
+{
+	if (this->is_started == true)
+		return -1;
 
+	if ( (adc_num == 0) || (adc_num > ADC_COUNT) )
+		return -1;
+
+	if ( (channel_num == 0) || (channel_num > CHANNELS_PER_ADC) )
+		return -1;
+
+	int8_t injected_rank = spin.adc.enableInjectedChannel(adc_num, channel_num);
+	if (injected_rank < 0)
+		return -1;
+
+	this->injected_ranks[adc_num-1][channel_num-1] = injected_rank;
+
+	return 0;
+}
+
+injected_handle_t DataAPI::buildInjectedHandle(uint8_t adc_num, uint8_t channel_num)
+{
+	injected_handle_t handle = {0, 0, nullptr};
+
+	if ( (adc_num == 0) || (adc_num > ADC_COUNT) || (channel_num == 0) || (channel_num > CHANNELS_PER_ADC) )
+		return handle;
+
+	uint8_t injected_rank = this->injected_ranks[adc_num-1][channel_num-1];
+	if (injected_rank != 0)
+	{
+		handle.adc_num       = adc_num;
+		handle.channel_num   = channel_num;
+		handle.data_register = spin.adc.getInjectedDataRegister(adc_num, injected_rank);
+	}
+
+	return handle;
+}
+
+float32_t DataAPI::readChannelInjected(const injected_handle_t& handle)
+{
+	if ( (this->is_started == false) || (handle.data_register == nullptr) )
+		return NO_VALUE;
+
+	uint16_t raw_value = (uint16_t)(*handle.data_register) << this->injected_raw_shifts[handle.adc_num-1];
+
+	return data_conversion_convert_raw_value(handle.adc_num, handle.channel_num, raw_value);
+}
+
+int8_t DataAPI::setChannelFilter(const channel_handle_t& handle, filter_type_t type, uint32_t param1, uint32_t param2)
+{
+	if (handle.rank == 0)
+		return -1;
+
+	return data_dispatch_set_filter(handle.adc_num, handle.rank, type, param1, param2);
+}
+
+float32_t DataAPI::getChannelFiltered(const channel_handle_t& handle, uint8_t* dataValid)
+{
+	uint32_t output;
+
+	if ( (this->is_started == false) || (handle.rank == 0) ||
+	     (data_dispatch_get_filter_output(handle.adc_num, handle.rank, output) != 0) )
+	{
 		if (dataValid != nullptr)
 		{
-			if (peekValue != NO_VALUE)
-			{
-				*dataValid = DATA_IS_OLD;
-			}
-			else
-			{
-				*dataValid = DATA_IS_MISSING;
-			}
+			*dataValid = DATA_IS_MISSING;
 		}
-		return peekValue;
+		return NO_VALUE;
 	}
+
+	if (dataValid != nullptr)
+	{
+		*dataValid = DATA_IS_OK;
+	}
+
+	// Filter output is a raw value in Q16 format
+	float32_t raw_value = (float32_t)output / 65536.f;
+	return data_conversion_convert_fractional_raw_value(handle.adc_num, handle.channel_num, raw_value);
 }
 
-uint8_t DataAPI::getChannelRank(uint8_t adc_num, uint8_t channel_num)
+int8_t DataAPI::setChannelStatsWindow(const channel_handle_t& handle, uint32_t window_length)
 {
-	if ( (adc_num > ADC_COUNT) || (channel_num > CHANNELS_PER_ADC) )
-		return 0;
+	if (handle.rank == 0)
+		return -1;
 
-	uint8_t adc_index = adc_num-1;
-	uint8_t channel_index = channel_num-1;
+	return data_dispatch_set_stats_window(handle.adc_num, handle.rank, window_length);
+}
 
-	return this->channels_ranks[adc_index][channel_index];
+channel_stats_t DataAPI::getChannelStats(const channel_handle_t& handle)
+{
+	channel_stats_t stats = {NO_VALUE, NO_VALUE, NO_VALUE, NO_VALUE, 0, 0};
+
+	stats_snapshot_t snapshot;
+	if ( (this->is_started == false) || (handle.rank == 0) ||
+	     (data_dispatch_get_stats(handle.adc_num, handle.rank, snapshot) != 0) )
+	{
+		return stats;
+	}
+
+	uint8_t adc_num     = handle.adc_num;
+	uint8_t channel_num = handle.channel_num;
+
+	// Conversion may be decreasing
+	float32_t converted_min = data_conversion_convert_raw_value(adc_num, channel_num, snapshot.min);
+	float32_t converted_max = data_conversion_convert_raw_value(adc_num, channel_num, snapshot.max);
+	stats.min = (converted_min < converted_max) ? converted_min : converted_max;
+	stats.max = (converted_min < converted_max) ? converted_max : converted_min;
+
+	float32_t raw_mean = (float32_t)snapshot.sum / snapshot.count;
+	stats.mean = data_conversion_convert_fractional_raw_value(adc_num, channel_num, raw_mean);
+
+	// Variance is computed on integers to avoid cancellation:
+	// count*variance = sum_squares - sum^2/count, sum^2 fitting in 64 bits.
+	uint64_t centered_sum_squares = snapshot.sum_squares - ((uint64_t)snapshot.sum * snapshot.sum) / snapshot.count;
+	float32_t raw_variance = (float32_t)centered_sum_squares / snapshot.count;
+
+	// mean(x^2) = variance + mean^2, variance being scaled
+	// by the slope of the conversion around the mean.
+	float32_t slope = data_conversion_convert_fractional_raw_value(adc_num, channel_num, raw_mean + 0.5f) -
+	                  data_conversion_convert_fractional_raw_value(adc_num, channel_num, raw_mean - 0.5f);
+	float32_t mean_square = slope*slope*raw_variance + stats.mean*stats.mean;
+	arm_sqrt_f32(mean_square, &stats.rms);
+
+	stats.count         = snapshot.count;
+	stats.window_number = snapshot.window_number;
+
+	return stats;
 }
 
-uint8_t DataAPI::getChannelNumber(uint8_t adc_num, uint8_t twist_pin)
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+int8_t DataAPI::addChannelToCapture(const channel_handle_t& handle)
 {
-	switch (adc_num)
+	if (handle.rank == 0)
+		return -1;
+
+	int8_t capture_index = data_capture_add_channel(handle.adc_num, handle.rank);
+	if (capture_index >= 0)
 	{
-	case 1:
-		switch (twist_pin)
-		{
-			case 1:
-				return 14;
-				break;
-			case 2:
-				return 11;
-				break;
-			case 5:
-				return 5;
-				break;
-			case 24:
-				return 6;
-				break;
-			case 25:
-				return 7;
-				break;
-			case 26:
-				return 8;
-				break;
-			case 27:
-				return 9;
-				break;
-			case 29:
-				return 1;
-				break;
-			case 30:
-				return 2;
-				break;
-			case 31:
-				return 5;
-				break;
-			case 37:
-				return 12;
-				break;
-			case 50:
-				return 3;
-				break;
-			case 51:
-				return 4;
-				break;
-			default:
-				return 0;
-				break;
-		}
-		break;
-	case 2:
-		switch (twist_pin)
-		{
-			case 1:
-				return 14;
-				break;
-			case 6:
-				return 15;
-				break;
-			case 24:
-				return 6;
-				break;
-			case 25:
-				return 7;
-				break;
-			case 26:
-				return 8;
-				break;
-			case 27:
-				return 9;
-				break;
-			case 29:
-				return 1;
-				break;
-			case 30:
-				return 2;
-				break;
-			case 32:
-				return 13;
-				break;
-			case 34:
-				return 3;
-				break;
-			case 35:
-				return 5;
-				break;
-			case 42:
-				return 12;
-				break;
-			case 43:
-				return 11;
-				break;
-			case 44:
-				return 4;
-				break;
-			case 45:
-				return 17;
-				break;
-			default:
-				return 0;
-				break;
-		}
-		break;
-	case 3:
-		switch (twist_pin)
-		{
-			case 4:
-				return 5;
-				break;
-			case 31:
-				return 12;
-				break;
-			case 37:
-				return 1;
-				break;
-			default:
-				return 0;
-				break;
-		}
-		break;
-	case 4:
-		switch (twist_pin)
-		{
-			case 2:
-				return 3;
-				break;
-			case 5:
-				return 4;
-				break;
-			case 6:
-				return 5;
-				break;
-			default:
-				return 0;
-				break;
-		}
-		break;
-	case 5:
-		switch (twist_pin)
-		{
-			case 12:
-				return 1;
-				break;
-			case 14:
-				return 2;
-				break;
-			default:
-				return 0;
-				break;
-		}
-		break;
-	default:
+		this->capture_handles[capture_index] = handle;
+	}
+
+	return capture_index;
+}
+
+int8_t DataAPI::setChannelCaptureLevelTrigger(const channel_handle_t& handle, float32_t level, capture_trigger_t edge)
+{
+	if ( (edge != capture_trigger_rising) && (edge != capture_trigger_falling) )
+		return -1;
+
+	int8_t capture_index = this->addChannelToCapture(handle);
+	if (capture_index < 0)
+		return -1;
+
+	// Invert channel conversion to get the raw level
+	float32_t value_at_zero = data_conversion_convert_fractional_raw_value(handle.adc_num, handle.channel_num, 0);
+	float32_t slope = data_conversion_convert_fractional_raw_value(handle.adc_num, handle.channel_num, 1) - value_at_zero;
+	if (slope == 0)
+		return -1;
+
+	float32_t raw_level = (level - value_at_zero) / slope;
+
+	// A negative gain reverses edges
+	if (slope < 0)
+	{
+		edge = (edge == capture_trigger_rising) ? capture_trigger_falling : capture_trigger_rising;
+	}
+
+	if (raw_level < 0)
+	{
+		raw_level = 0;
+	}
+	else if (raw_level > UINT16_MAX)
+	{
+		raw_level = UINT16_MAX;
+	}
+
+	return data_capture_set_trigger(edge, capture_index, (uint16_t)(raw_level + 0.5f));
+}
+#endif
+
+int8_t DataAPI::checkOversamplingTiming(uint8_t adc_num, uint32_t ratio, adc_ovs_mode_t mode)
+{
+	// In triggered mode, each conversion waits for its own trigger
+	if ( (ratio <= 1) || (mode == ovs_triggered) )
+		return 0;
+
+	adc_ev_src_t trigger = spin.adc.getTriggerSource(adc_num);
+	if (trigger == software)
 		return 0;
-		break;
+
+	// PWM period may not be configured yet: it will be checked on start
+	uint32_t period_ns = hrtim_period_Master_get_us() * 1000;
+	if (period_ns == 0)
+		return 0;
+
+	// Number of regular conversions triggered by a single HRTIM event
+	uint32_t conversions_per_trigger = spin.adc.getEnabledChannelsCount(adc_num);
+	uint32_t discontinuous_count     = spin.adc.getDiscontinuousCount(adc_num);
+	if ( (discontinuous_count != 0) && (discontinuous_count < conversions_per_trigger) )
+	{
+		conversions_per_trigger = discontinuous_count;
 	}
+	if (conversions_per_trigger == 0)
+	{
+		conversions_per_trigger = 1;
+	}
+
+	uint32_t burst_duration_ns = ratio * conversions_per_trigger * ADC_CONVERSION_TIME_NS;
+	if (burst_duration_ns > period_ns)
+		return -1;
+
+	return 0;
+}
+
+uint8_t DataAPI::getChannelRank(uint8_t adc_num, uint8_t channel_num)
+{
+	if ( (adc_num > ADC_COUNT) || (channel_num > CHANNELS_PER_ADC) )
+		return 0;
+
+	uint8_t adc_index = adc_num-1;
+	uint8_t channel_index = channel_num-1;
+
+	return this->channels_ranks[adc_index][channel_index];
 }
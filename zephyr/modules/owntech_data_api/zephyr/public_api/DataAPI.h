@@ -38,8 +38,14 @@
 // ARM CMSIS library
 #include <arm_math.h>
 
+// OwnTech API
+#include "adc.h"
+
 // Current module private functions
 #include "../src/data_conversion.h"
+#include "../src/data_dispatch.h"
+#include "../src/data_capture.h"
+#include "../src/spin_adc_pins.h"
 
 #define ADC_1 1
 #define ADC_2 2
@@ -51,6 +57,7 @@
 
 #ifdef CONFIG_SHIELD_TWIST
 #define CHANNEL_TOKEN(node_id) DT_STRING_TOKEN(node_id, channel_name),
+#define SHIELD_CHANNEL_COUNTER(node_id) +1
 #endif
 
 
@@ -65,6 +72,53 @@ typedef enum
 } channel_t;
 #endif
 
+/**
+ * Direct access information for an enabled channel.
+ * A rank of 0 indicates the channel is not enabled.
+ */
+typedef struct
+{
+	uint8_t adc_num;     // Number of the ADC acquiring the channel
+	uint8_t channel_num; // ADC channel number, also used as conversion slot
+	uint8_t rank;        // Rank of the channel in the ADC sequence
+} channel_handle_t;
+
+/**
+ * Direct access information for an injected channel.
+ * A null data register indicates the channel is not injected.
+ */
+typedef struct
+{
+	uint8_t adc_num;                  // Number of the ADC acquiring the channel
+	uint8_t channel_num;              // ADC channel number, also used as conversion slot
+	volatile uint32_t* data_register; // ADC register holding the latest injected value
+} injected_handle_t;
+
+/**
+ * Statistics of a channel over a window of acquired values,
+ * expressed in the relevant unit for the channel.
+ * A count of 0 indicates no statistics are available.
+ */
+typedef struct
+{
+	float32_t min;           // Minimum value
+	float32_t max;           // Maximum value
+	float32_t mean;          // Average value
+	float32_t rms;           // Root mean square value
+	uint32_t  count;         // Number of values in the window
+	uint32_t  window_number; // Number of windows completed, identifies the window
+} channel_stats_t;
+
+/**
+ * Freshness of the latest value acquired on a channel.
+ * Sequence number 0 indicates no value was acquired yet.
+ */
+typedef struct
+{
+	uint32_t sequence_number; // Number of values acquired since start, including the latest one
+	uint32_t age;             // HRTIM master periods elapsed since the latest value was dispatched
+} channel_sequence_t;
+
 enum class DispatchMethod_t
 {
 	on_dma_interrupt,
@@ -81,6 +135,10 @@ static const uint8_t CHANNELS_PER_ADC = 19;
 // Define "no value" as an impossible, out of range value
 const float32_t NO_VALUE = -10000;
 
+#ifdef CONFIG_SHIELD_TWIST
+static const uint8_t SHIELD_CHANNELS_COUNT = 0 DT_FOREACH_STATUS_OKAY(adc_channels, SHIELD_CHANNEL_COUNTER);
+#endif
+
 const uint8_t DATA_IS_OK      = 0;
 const uint8_t DATA_IS_OLD     = 1;
 const uint8_t DATA_IS_MISSING = 2;
@@ -121,12 +179,44 @@ public:
 	 *        triggered by the HRTIM, so the board must be configured as
 	 *        a power converted to enable HRTIM events.
 	 *        All other ADCs remain software triggered, thus will only be
-	 *        acquired when triggerAcquisition() is called.
+	 *        acquired when triggerAcquisition() is called, unless their
+	 *        trigger source is changed using spin.adc.configureTriggerSource():
+	 *        all ADCs use DMA, and HRTIM-triggered ADCs are acquired
+	 *        without CPU involvement.
 	 *
 	 * @note  This function must be called *before* ADC is started.
+	 *
+	 * @note  To have channels of ADC 1 and 2 sampled simultaneously, call
+	 *        data.configureDualSampling(true) before starting the module.
+	 *        ADC 2 is then triggered along with ADC 1 by hrtim_ev1, and
+	 *        channels with the same rank form pairs: I1_LOW/I2_LOW,
+	 *        V1_LOW/V2_LOW and V_HIGH/I_HIGH.
 	 */
 	void enableTwistDefaultChannels();
 
+	/**
+	 * @brief This function is used to add a shield channel to the injected
+	 *        sequence of a given ADC. Injected conversions take precedence
+	 *        over regular conversions, and their results are read directly
+	 *        from the ADC registers using data.readInjected(), without any
+	 *        DMA transfer or dispatch. This is intended for channels that
+	 *        must be acted upon within the same PWM period.
+	 *
+	 * @note  A channel can be both enabled using data.enableShieldChannel()
+	 *        and injected. Up to 4 channels can be injected on each ADC.
+	 *
+	 * @note  By default, injected sequence is software triggered: use
+	 *        data.configureInjectedTrigger() to have it triggered by HRTIM.
+	 *
+	 * @note  This function must be called *before* ADC is started.
+	 *
+	 * @param adc_number Number of the ADC on which channel is to be injected.
+	 * @param channel_name Name of the channel using enumeration channel_t.
+	 *
+	 * @return 0 if channel was correctly injected, -1 if there was an error.
+	 */
+	int8_t enableShieldInjectedChannel(uint8_t adc_num, channel_t channel_name);
+
 	/**
 	 * @brief Function to access the acquired data for specified channel.
 	 *        This function provides a buffer in which all data that
@@ -143,7 +233,8 @@ public:
 	 * @note  When calling this function, it invalidates the buffer
 	 *        returned by a previous call to the same function.
 	 *        However, different channels buffers are independent
-	 *        from each other.
+	 *        from each other. Until then, the returned values are
+	 *        guaranteed not to be overwritten by new acquisitions.
 	 *
 	 * @note  When using this functions, the user is responsible for data
 	 *        conversion. Use matching data.convert*() function
@@ -164,6 +255,87 @@ public:
 	 */
 	uint16_t* getRawValues(channel_t channel, uint32_t& number_of_values_acquired);
 
+	/**
+	 * @brief Function to access the acquired data for specified channel
+	 *        using a reader cursor obtained with data.registerCursor().
+	 *        Each cursor has its own view on the channel buffer: all
+	 *        readers of a channel see every value, independently from
+	 *        each other and from data.getRawValues()/data.getLatest().
+	 *
+	 * @note  The first call with a cursor activates it: only values
+	 *        acquired after that call are provided.
+	 *
+	 * @param channel Name of the shield channel from which to obtain values.
+	 * @param number_of_values_acquired Pass an uint32_t variable.
+	 *        This variable will be updated with the number of values that
+	 *        are present in the returned buffer.
+	 * @param cursor Cursor obtained from data.registerCursor().
+	 *
+	 * @return Pointer to a buffer in which the acquired values are stored.
+	 *         If number_of_values_acquired is 0, do not try to access the
+	 *         buffer as it may be nullptr. The buffer holds at most
+	 *         CONFIG_OWNTECH_DATA_API_CHANNEL_BUFFER_SIZE values, and its
+	 *         oldest values are overwritten once the channel buffer wraps:
+	 *         process it before that many new values are acquired.
+	 */
+	uint16_t* getRawValues(channel_t channel, uint32_t& number_of_values_acquired, uint8_t cursor);
+
+	/**
+	 * @brief Function to access the acquired data for specified channel
+	 *        along with the time at which each value was acquired.
+	 *        This function behaves as data.getRawValues(), and shares
+	 *        its buffer: use either one or the other on a channel.
+	 *
+	 * @note  Timestamps are only recorded if CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+	 *        is set in prj.conf. Otherwise, timestamps is set to nullptr.
+	 *
+	 * @note  Timestamps are expressed in HRTIM master periods since start,
+	 *        and master counter value within the period. They are common to
+	 *        all ADCs, so that values of different ADCs can be correlated.
+	 *        Time is read once per dispatch: values are stamped by evenly
+	 *        spreading them between two consecutive dispatches.
+	 *
+	 * @param channel Name of the shield channel from which to obtain values.
+	 * @param number_of_values_acquired Pass an uint32_t variable.
+	 *        This variable will be updated with the number of values that
+	 *        are present in the returned buffer.
+	 * @param timestamps Pass a const sample_timestamp_t* variable. This
+	 *        variable will be updated with a buffer holding the timestamp
+	 *        of each returned value.
+	 *
+	 * @return Pointer to a buffer in which the acquired values are stored.
+	 *         If number_of_values_acquired is 0, do not try to access the
+	 *         buffers as they may be nullptr.
+	 */
+	uint16_t* getRawValuesTimed(channel_t channel, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps);
+
+	/**
+	 * @brief Register a new reader on the channel, e.g. for a telemetry
+	 *        or logging task that needs every value without interfering
+	 *        with the control task.
+	 *
+	 * @note  Acquisition never waits for readers: if a reader does not
+	 *        read values fast enough, it loses its oldest values, which
+	 *        are counted by data.getOverrunCount(channel, cursor). Other
+	 *        readers, including the control task, are not affected.
+	 *        Release cursors that are no longer used with data.releaseCursor().
+	 *
+	 * @param channel Name of the shield channel to read.
+	 *
+	 * @return Cursor number to use with data.getRawValues(),
+	 *         or -1 if the channel is not enabled or no more cursor is
+	 *         available (see CONFIG_OWNTECH_DATA_API_MAX_CURSORS_PER_CHANNEL).
+	 */
+	int8_t registerCursor(channel_t channel);
+
+	/**
+	 * @brief Release a cursor previously obtained with data.registerCursor().
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param cursor Cursor to release.
+	 */
+	void releaseCursor(channel_t channel, uint8_t cursor);
+
 	/**
 	 * @brief Function to access the latest value available from the channel,
 	 *        expressed in the relevant unit for the data: Volts, Amperes, or
@@ -202,16 +374,302 @@ public:
 	 *        facultative. If this parameter is provided, it will be updated
 	 *        to indicate information about data. Possible values for this
 	 *        parameter will be:
-	 *        - DATA_IS_OK if returned data is a newly acquired data,
+	 *        - DATA_IS_OK if returned data is a newly acquired data, i.e.
+	 *        the newest value acquired, even if older ones were lost on overrun,
 	 *        - DATA_IS_OLD if returned data has already been provided before
 	 *        (no new data available since latest time this function was called),
 	 *        - DATA_IS_MISSING if returned data is NO_VALUE.
+	 * @param sequence Pointer to a channel_sequence_t variable. This parameter
+	 *        is facultative. If this parameter is provided, it will be updated
+	 *        with the sequence number and age of the latest acquired value,
+	 *        as returned by data.getSequenceInfo().
 	 *
 	 * @return Latest acquired measure for the channel.
 	 *         If no value was acquired in this channel yet, return value is NO_VALUE.
 	 *
 	 */
-	float32_t getLatest(channel_t channel, uint8_t* dataValid = nullptr);
+	float32_t getLatest(channel_t channel, uint8_t* dataValid = nullptr, channel_sequence_t* sequence = nullptr);
+
+	/**
+	 * @brief Function to access the raw values acquired for specified
+	 *        channel between the two latest dispatches, without any copy.
+	 *        The returned view points directly to the DMA buffer: use
+	 *        view[i] to access the i-th value, i ranging from 0 to
+	 *        view.count-1.
+	 *
+	 * @note  This function can't be called before the channel is enabled
+	 *        and the DataAPI module is started, either explicitly
+	 *        or by starting the Uninterruptible task.
+	 *
+	 * @note  This function does not alter the buffers used by the
+	 *        data.get*() functions and can be called at any time.
+	 *        However, to drop the dispatch copy and have the view remain
+	 *        valid for a whole period, call data.setDispatchCopy(false)
+	 *        before starting the module.
+	 *
+	 * @param channel Name of the shield channel from which to obtain values.
+	 *
+	 * @return View on the acquired values. If view.count is 0,
+	 *         do not try to access the values.
+	 */
+	channel_view_t getRawView(channel_t channel);
+
+	/**
+	 * @brief Function to obtain the number of values that have been
+	 *        lost for the specified channel because its buffer wrapped
+	 *        before they were read, i.e. values were not retrieved fast
+	 *        enough using data.getRawValues(). Oldest values are lost
+	 *        first: the buffer always holds the latest values.
+	 *
+	 * @note  data.getLatest() is not affected by overrun: it always returns
+	 *        the newest acquired value, and only flags it DATA_IS_OLD if no
+	 *        value was acquired since its previous call.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Number of lost values since module was started.
+	 */
+	uint32_t getOverrunCount(channel_t channel);
+
+	/**
+	 * @brief Function to obtain the number of values that have been
+	 *        lost by a reader cursor obtained with data.registerCursor().
+	 *        Each cursor has its own count.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param cursor Cursor obtained from data.registerCursor().
+	 *
+	 * @return Number of lost values since the cursor was registered.
+	 */
+	uint32_t getOverrunCount(channel_t channel, uint8_t cursor);
+
+	/**
+	 * @brief Function to obtain the sequence number and age of the latest
+	 *        value acquired for the specified channel.
+	 *        The sequence number counts all values acquired since start,
+	 *        including values lost on overrun: the difference between
+	 *        two calls is the number of values acquired in between. The age is the
+	 *        number of HRTIM master periods elapsed since the latest value
+	 *        was dispatched: a stalled DMA or a stopped ADC trigger makes it
+	 *        grow beyond the dispatch period (one period for interrupt
+	 *        dispatch, the task period for task dispatch).
+	 *
+	 * @note  Age is only relevant when the HRTIM master period is configured.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param sequence Output parameter: sequence number and age of the
+	 *        latest value. Both are 0 if no value was acquired yet.
+	 *
+	 * @return 0 if a value was acquired for the channel, -1 otherwise.
+	 */
+	int8_t getSequenceInfo(channel_t channel, channel_sequence_t& sequence);
+
+	/**
+	 * @brief Function to access the latest pair of simultaneous values of
+	 *        two channels acquired by ADC 1 and ADC 2 in dual sampling
+	 *        mode, expressed in the relevant unit for the channels.
+	 *        Both values are guaranteed to come from the same conversion,
+	 *        which makes them suitable for power or impedance computation.
+	 *
+	 * @note  Channels must have the same rank on ADC 1 and ADC 2, i.e.
+	 *        they must have been enabled in the same order on both ADCs,
+	 *        and dual sampling must have been enabled using
+	 *        data.configureDualSampling().
+	 *
+	 * @param channel_a Name of the first shield channel.
+	 * @param channel_b Name of the second shield channel.
+	 * @param value_a Output parameter: latest value of the first channel.
+	 * @param value_b Output parameter: latest value of the second channel.
+	 *
+	 * @return 0 if a pair was available, -1 if channels are not paired
+	 *         or no value was acquired yet.
+	 */
+	int8_t peekPair(channel_t channel_a, channel_t channel_b, float32_t& value_a, float32_t& value_b);
+
+	/**
+	 * @brief Function to access the raw values of two channels acquired
+	 *        by ADC 1 and ADC 2 in dual sampling mode between the two
+	 *        latest dispatches, without any copy. Both views are built
+	 *        from the same dispatched block: they have the same count,
+	 *        and view_a[i] and view_b[i] were acquired simultaneously.
+	 *
+	 * @note  Same constraints as data.peekPair() apply.
+	 *
+	 * @param channel_a Name of the first shield channel.
+	 * @param channel_b Name of the second shield channel.
+	 * @param view_a Output parameter: view on the first channel values.
+	 * @param view_b Output parameter: view on the second channel values.
+	 *
+	 * @return 0 if views hold values, -1 otherwise.
+	 */
+	int8_t getPairedRawViews(channel_t channel_a, channel_t channel_b, channel_view_t& view_a, channel_view_t& view_b);
+
+	/**
+	 * @brief Function to apply a boxcar filter to the specified channel:
+	 *        each filter output is the average of a block of consecutive
+	 *        acquired values. Filter is applied on dispatch, on all
+	 *        acquired values, independently of data.get*() functions.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param length Number of values averaged, from 2 to 65535.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setBoxcarFilter(channel_t channel, uint32_t length);
+
+	/**
+	 * @brief Function to apply a CIC decimation filter to the specified
+	 *        channel. This provides a better rejection than a boxcar filter
+	 *        of same decimation at the cost of a longer response.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param order Number of stages of the filter, from 1 to 3.
+	 * @param decimation Decimation ratio. decimation^order must not
+	 *        exceed 65536.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setCicFilter(channel_t channel, uint8_t order, uint32_t decimation);
+
+	/**
+	 * @brief Function to apply a first-order low-pass IIR filter to the
+	 *        specified channel: output = output + (value - output)/2^shift.
+	 *        This filter does not decimate.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param shift Smoothing factor, from 1 to 15.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setIirFilter(channel_t channel, uint8_t shift);
+
+	/**
+	 * @brief Function to remove the filter applied to the specified channel.
+	 *
+	 * @param channel Name of the shield channel.
+	 */
+	void disableFilter(channel_t channel);
+
+	/**
+	 * @brief Function to obtain the latest output of the filter applied
+	 *        to the specified channel, converted to the relevant unit.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param dataValid Pointer to an uint8_t variable. This parameter is
+	 *        facultative. If this parameter is provided, it will be updated
+	 *        to indicate information about data. Possible values for this
+	 *        parameter will be:
+	 *        - DATA_IS_OK if a filter output is available
+	 *        - DATA_IS_MISSING if returned data is NO_VALUE.
+	 *
+	 * @return Latest filter output. If filter did not produce an
+	 *         output yet, return value is NO_VALUE.
+	 */
+	float32_t getFiltered(channel_t channel, uint8_t* dataValid = nullptr);
+
+	/**
+	 * @brief Function to enable running statistics on the specified
+	 *        channel: minimum, maximum, mean and RMS values are computed
+	 *        over consecutive windows of acquired values. Accumulation is
+	 *        done on dispatch using integer arithmetic, on all acquired
+	 *        values, independently of data.get*() functions.
+	 *
+	 * @note  This function can be called before or after the module is
+	 *        started. Any previous accumulation is discarded.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param window_length Number of values in a window, up to 65536,
+	 *        or 0 to disable statistics.
+	 *
+	 * @return 0 if statistics were configured, -1 if there was an error.
+	 */
+	int8_t setStatsWindow(channel_t channel, uint32_t window_length);
+
+	/**
+	 * @brief Function to obtain the statistics of the latest completed
+	 *        window of the specified channel. Statistics of a window are
+	 *        published at once, so that returned values are consistent
+	 *        with each other. This function is intended to be called from
+	 *        a background task.
+	 *
+	 * @note  Mean and RMS values are exact for linear conversions. For
+	 *        other conversions, they are obtained by linearizing the
+	 *        conversion around the raw mean value.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Statistics of the latest window. If no window was
+	 *         completed yet, count is 0 and values are NO_VALUE.
+	 *         Use window_number to detect a new window.
+	 */
+	channel_stats_t getStats(channel_t channel);
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+	/**
+	 * @brief Function to add the specified channel to the capture.
+	 *        Captured channels are recorded on dispatch at full
+	 *        acquisition rate once capture is armed.
+	 *
+	 * @note  This function can't be called before the channel is enabled,
+	 *        nor while capture is armed. Adding a channel discards any
+	 *        previously frozen capture.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Index of the channel in the capture, to be used with
+	 *         data.readCapture(), or -1 if channel can't be captured.
+	 */
+	int8_t addCaptureChannel(channel_t channel);
+
+	/**
+	 * @brief Function to trigger the capture when the specified channel
+	 *        crosses a level. Channel is added to the capture if it is
+	 *        not already captured.
+	 *
+	 * @note  Level is converted to a raw value using the current
+	 *        conversion parameters of the channel, assuming they
+	 *        are linear. Level crossing is evaluated on raw values.
+	 *
+	 * @param channel Name of the shield channel.
+	 * @param level Level to cross, in the relevant unit.
+	 * @param edge capture_trigger_rising or capture_trigger_falling.
+	 *
+	 * @return 0 if trigger was set, -1 otherwise.
+	 */
+	int8_t setCaptureLevelTrigger(channel_t channel, float32_t level, capture_trigger_t edge);
+#endif
+
+	/**
+	 * @brief Function to read the latest injected conversion of the
+	 *        specified channel, converted to the relevant unit. Value
+	 *        is read directly from the ADC register.
+	 *
+	 * @note  This function can't be called before the channel is injected
+	 *        and the DataAPI module is started. Before the first injected
+	 *        conversion, the raw value read is 0.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Latest injected value, or NO_VALUE if channel is not injected.
+	 */
+	float32_t readInjected(channel_t channel);
+
+	/**
+	 * @brief Function to read the latest injected conversion of the
+	 *        specified channel as a raw 12-bit value. Injected conversions
+	 *        are never oversampled.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Latest injected raw value, or 0 if channel is not injected.
+	 */
+	uint16_t readInjectedRaw(channel_t channel);
 
 	/**
 	 * @brief Use this function to convert values obtained using matching
@@ -227,6 +685,40 @@ public:
 	 */
 	float32_t convert(channel_t channel, uint16_t raw_value);
 
+	/**
+	 * @brief Use this function to convert a whole buffer of values obtained
+	 *        using matching data.get*RawValues() function to relevant unit
+	 *        for the data: Volts, Amperes, or Degree Celcius. Conversion
+	 *        is done in one pass, which is much faster than calling
+	 *        data.convert() on each value.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel from which the values originate.
+	 * @param raw_values Buffer of raw values obtained from the channel.
+	 * @param values_count Number of values in the buffer.
+	 * @param converted_values Buffer able to hold at least values_count
+	 *        values, that will be filled with the converted values.
+	 */
+	void convertBuffer(channel_t channel, const uint16_t* raw_values, size_t values_count, float32_t* converted_values);
+
+	/**
+	 * @brief Use this function to obtain the average of a buffer of values
+	 *        obtained using matching data.get*RawValues() function, in the
+	 *        relevant unit for the data: Volts, Amperes, or Degree Celcius.
+	 *        Values are averaged before conversion when possible, so this
+	 *        function does not require any intermediate buffer.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel from which the values originate.
+	 * @param raw_values Buffer of raw values obtained from the channel.
+	 * @param values_count Number of values in the buffer.
+	 *
+	 * @return Average converted value, or 0 if values_count is 0.
+	 */
+	float32_t convertAverage(channel_t channel, const uint16_t* raw_values, size_t values_count);
+
 	/**
 	 * @brief Use this function to tweak the conversion values for the
 	 *        channel if default values are not accurate enough.
@@ -242,6 +734,116 @@ public:
 	 */
 	void setParameters(channel_t channel, float32_t gain, float32_t offset);
 
+	/**
+	 * @brief Use this function to set a third-order polynomial conversion
+	 *        for the channel: value = a0 + a1*raw + a2*raw^2 + a3*raw^3,
+	 *        with raw the 12-bit raw value. This is suited to sensors
+	 *        with a slight curvature.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *        The DataAPI must not have been started, neither explicitly
+	 *        nor by starting the Uninterruptible task.
+	 *
+	 * @param channel Name of the shield channel to set conversion values.
+	 * @param a0 Constant coefficient.
+	 * @param a1 First order coefficient.
+	 * @param a2 Second order coefficient.
+	 * @param a3 Third order coefficient.
+	 */
+	void setPolynomialParameters(channel_t channel, float32_t a0, float32_t a1, float32_t a2, float32_t a3);
+
+	/**
+	 * @brief Use this function to set a lookup-table conversion for the
+	 *        channel, suited to strongly non-linear sensors such as NTC
+	 *        thermistors. A table holding the converted value of each
+	 *        12-bit raw value is built by linear interpolation between
+	 *        anchors, so that each conversion is a single memory read.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *        The DataAPI must not have been started, neither explicitly
+	 *        nor by starting the Uninterruptible task. The number of tables
+	 *        is set by CONFIG_OWNTECH_DATA_API_CONVERSION_LUT_COUNT.
+	 *
+	 * @param channel Name of the shield channel to set conversion values.
+	 * @param anchors Converted values at evenly spaced raw values:
+	 *        anchor i is the value for raw value i*4095/(anchors_count-1).
+	 * @param anchors_count Number of anchors, from 2 to 33.
+	 *
+	 * @return 0 if conversion was set, -1 if anchors count is invalid
+	 *         or no table is available.
+	 */
+	int8_t setLookupTableParameters(channel_t channel, const float32_t* anchors, uint8_t anchors_count);
+
+	/**
+	 * @brief Use this function to convert values obtained using matching
+	 *        data.get*RawValues() function to relevant unit for the data,
+	 *        expressed in fixed-point Q15 format as a fraction of the
+	 *        channel full scale (see data.setFixedPointFullScale()).
+	 *        With default linear conversion, this function does not use
+	 *        the FPU.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel from which the value originates
+	 * @param raw_value Raw value obtained from which the value originates
+	 *
+	 * @return Converted value divided by channel full scale, in Q15 format.
+	 */
+	q15_t convertQ15(channel_t channel, uint16_t raw_value);
+
+	/**
+	 * @brief Same as data.convertQ15() with Q31 output format.
+	 *
+	 * @param channel Name of the shield channel from which the value originates
+	 * @param raw_value Raw value obtained from which the value originates
+	 *
+	 * @return Converted value divided by channel full scale, in Q31 format.
+	 */
+	q31_t convertQ31(channel_t channel, uint16_t raw_value);
+
+	/**
+	 * @brief Function to access the latest value available from the channel,
+	 *        expressed in fixed-point Q15 format as a fraction of the
+	 *        channel full scale. As data.peek(), this function will not
+	 *        touch anything in the buffer.
+	 *
+	 * @note  This function can't be called before the channel is enabled
+	 *        and the DataAPI module is started, either explicitly
+	 *        or by starting the Uninterruptible task.
+	 *
+	 * @param channel Name of the shield channel from which to obtain value.
+	 * @param dataValid Pointer to an uint8_t variable. This parameter is
+	 *        facultative. If this parameter is provided, it will be updated
+	 *        to DATA_IS_OK if a value is available, or DATA_IS_MISSING
+	 *        otherwise, in which case returned value is 0.
+	 *
+	 * @return Latest available value from the given channel in Q15 format.
+	 */
+	q15_t peekQ15(channel_t channel, uint8_t* dataValid = nullptr);
+
+	/**
+	 * @brief Use this function to set the full scale of the channel for
+	 *        fixed-point conversion, i.e. the value in the relevant unit
+	 *        that is represented by 1 in Q15 and Q31 formats. If not set,
+	 *        full scale defaults to the largest absolute value that the
+	 *        channel can output with its conversion parameters.
+	 *
+	 * @note  This function can't be called before the channel is enabled.
+	 *
+	 * @param channel Name of the shield channel to set full scale.
+	 * @param full_scale Full scale, strictly positive.
+	 */
+	void setFixedPointFullScale(channel_t channel, float32_t full_scale);
+
+	/**
+	 * @brief Get the full scale of the channel for fixed-point conversion.
+	 *
+	 * @param channel Name of the shield channel.
+	 *
+	 * @return Value in the relevant unit represented by 1 in Q15 and Q31 formats.
+	 */
+	float32_t getFixedPointFullScale(channel_t channel);
+
 	/**
 	 * @brief Retrieve stored parameters from Flash memory and configure ADC parameters
 	 *
@@ -274,6 +876,21 @@ public:
 	 */
 	int8_t enableAcquisition(uint8_t adc_num, uint8_t pin_num);
 
+	/**
+	 * @brief This function is used to add a Spin PIN to the injected
+	 *        sequence of a given ADC. Injected values are read using
+	 *        data.readInjected(), without any DMA transfer or dispatch.
+	 *
+	 * @note  This function must be called *before* ADC is started.
+	 *        Up to 4 pins can be injected on each ADC.
+	 *
+	 * @param adc_number Number of the ADC on which acquisition is to be done.
+	 * @param pin_num Number of the Spin pin to acquire.
+	 *
+	 * @return 0 if pin was correctly injected, -1 if there was an error.
+	 */
+	int8_t enableInjectedAcquisition(uint8_t adc_num, uint8_t pin_num);
+
 	/**
 	 * @brief This functions manually starts the acquisition chain.
 	 *
@@ -302,7 +919,12 @@ public:
 	 *         Error is triggered when dispatch method is set to
 	 *         be external, but the repetition value has not provided.
 	 *         Another source of error is trying to start
-	 *         Data Acquisition after it has already been started.
+	 *         Data Acquisition after it has already been started,
+	 *         or dual sampling being enabled while ADC 1 and ADC 2
+	 *         do not have the same number of enabled channels.
+	 *         Start is also refused when the DMA buffers required by
+	 *         the configuration exceed CONFIG_OWNTECH_DATA_API_DMA_BUFFERS_SIZE,
+	 *         or when no DMA channel is left for an ADC.
 	 */
 	int8_t start();
 
@@ -364,11 +986,83 @@ public:
 	void setRepetitionsBetweenDispatches(uint32_t repetition);
 
 	/**
-	 * @brief Triggers an acquisition on a given ADC. Each channel configured
-	 *        on this ADC will be acquired one after the other until all
-	 *        configured channels have been acquired.
+	 * @brief Indicates whether dispatch copies acquired values from
+	 *        DMA buffers to per-channel buffers.
 	 *
-	 * @note  This function can't be called before the at least one channel
+	 *        When copy is disabled, dispatch only records the position
+	 *        of the latest acquired values in DMA buffers, which are then
+	 *        only accessible using data.getRawView() and data.peek*()
+	 *        functions. data.getRawValues() and data.getLatest() will
+	 *        not return any value in that case.
+	 *
+	 * @note  This function must be called *before* the module is started.
+	 *
+	 * @param enable_copy Set to false to disable the copy.
+	 *        (default value: true)
+	 */
+	void setDispatchCopy(bool enable_copy);
+
+	/**
+	 * @brief Configures ADC 1 and ADC 2 in dual regular simultaneous
+	 *        mode: each channel of ADC 2 is sampled at the same instant
+	 *        as the channel with the same rank on ADC 1, on ADC 1 trigger
+	 *        (ADC 2 trigger source is ignored). Pairs of values are
+	 *        transferred by a single DMA stream, which halves DMA requests.
+	 *
+	 *        All data.get*() and data.peek*() functions remain available,
+	 *        while data.peekPair() and data.getPairedRawViews() provide
+	 *        phase-coherent access to pairs of values.
+	 *
+	 * @note  This function must be called *before* the module is started.
+	 *
+	 * @note  ADC 1 and ADC 2 must have the same number of enabled channels
+	 *        when the module is started. Otherwise, module start fails.
+	 *
+	 * @param enable_dual_sampling Set to true to enable dual sampling.
+	 *        (default value: false)
+	 *
+	 * @return 0 if configuration was applied, -1 if module is started.
+	 */
+	int8_t configureDualSampling(bool enable_dual_sampling);
+
+	/**
+	 * @brief Configures the hardware oversampler of an ADC: each value
+	 *        provided by the ADC is then the sum of ratio consecutive
+	 *        conversions, right-shifted by shift. This reduces DMA
+	 *        traffic and dispatch load by the oversampling ratio.
+	 *
+	 *        Oversampled values have 12 + log2(ratio) - shift bits.
+	 *        Raw values obtained using data.get*RawValues() are thus
+	 *        wider than native values, but conversion functions take
+	 *        this into account: conversion parameters always apply to
+	 *        12-bit values.
+	 *
+	 * @note  This function must be called *before* the module is started.
+	 *
+	 * @note  In ovs_continuous mode, the whole burst is acquired on each
+	 *        trigger. For HRTIM-triggered ADCs, configuration is rejected
+	 *        if the burst does not fit in a PWM period. This is checked
+	 *        again when the module is started.
+	 *
+	 * @param adc_num Number of the ADC to configure.
+	 * @param ratio Oversampling ratio: power of two from 2 to 256,
+	 *        or 1 to disable oversampling.
+	 * @param shift Right shift applied to the result, not exceeding
+	 *        log2(ratio). Resulting values must fit in 16 bits.
+	 * @param mode ovs_continuous to acquire the whole burst on a single
+	 *        trigger (default), ovs_triggered to require a trigger for
+	 *        each conversion of the burst.
+	 *
+	 * @return 0 if configuration was applied, -1 otherwise.
+	 */
+	int8_t configureOversampling(uint8_t adc_num, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode = ovs_continuous);
+
+	/**
+	 * @brief Triggers an acquisition on a given ADC. Each channel configured
+	 *        on this ADC will be acquired one after the other until all
+	 *        configured channels have been acquired.
+	 *
+	 * @note  This function can't be called before the at least one channel
 	 *        is enabled on the ADC and the DataAPI module is started,
 	 *        either explicitly or by starting the Uninterruptible task.
 	 *
@@ -376,6 +1070,121 @@ public:
 	 */
 	void triggerAcquisition(uint8_t adc_num);
 
+	/**
+	 * @brief Configures the trigger of the injected sequence of an ADC.
+	 *        Injected sequence can only be triggered by HRTIM ADC
+	 *        triggers 2 and 4, which must be configured on the
+	 *        relevant timing unit.
+	 *
+	 * @note  This function must be called *before* the module is started.
+	 *
+	 * @param adc_num Number of the ADC to configure.
+	 * @param trigger_source hrtim_ev2, hrtim_ev4, or software (default).
+	 *
+	 * @return 0 if trigger was configured, -1 otherwise.
+	 */
+	int8_t configureInjectedTrigger(uint8_t adc_num, adc_ev_src_t trigger_source);
+
+	/**
+	 * @brief Triggers an acquisition of the injected sequence of an ADC,
+	 *        when it is software triggered.
+	 *
+	 * @param adc_num Number of the ADC on which to acquire injected channels.
+	 */
+	void triggerInjectedAcquisition(uint8_t adc_num);
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+	/**
+	 * @brief Removes all channels from the capture.
+	 */
+	void clearCaptureChannels();
+
+	/**
+	 * @brief Sets the capture trigger to an event rather than a
+	 *        level crossing. Use data.setCaptureLevelTrigger() to
+	 *        trigger on a level crossing.
+	 *
+	 * @param source capture_trigger_software to only trigger using
+	 *        data.triggerCapture(), or capture_trigger_safety to
+	 *        also trigger when Safety API reacts to a fault.
+	 *
+	 * @return 0 if trigger was set, -1 otherwise.
+	 */
+	int8_t setCaptureTrigger(capture_trigger_t source);
+
+	/**
+	 * @brief Arms the capture: captured channels are recorded until
+	 *        the trigger occurs, then during the post-trigger part
+	 *        of the capture, after which capture is frozen.
+	 *        A frozen capture is kept until capture is armed again.
+	 *
+	 * @note  Capture buffer is shared between captured channels:
+	 *        each channel holds data.getCaptureDepth() values.
+	 *        Level trigger is only considered once the pre-trigger
+	 *        part is full.
+	 *
+	 * @param pre_trigger_count Number of values of each channel to
+	 *        keep before the trigger.
+	 *
+	 * @return 0 if capture was armed, -1 if no channel is captured or
+	 *         pre-trigger count exceeds capture depth.
+	 */
+	int8_t armCapture(uint32_t pre_trigger_count);
+
+	/**
+	 * @brief Triggers an armed capture. This can be called from
+	 *        any context, including the critical task.
+	 */
+	void triggerCapture();
+
+	/**
+	 * @brief Get the current capture state.
+	 *
+	 * @return capture_idle, capture_armed, capture_triggered,
+	 *         or capture_frozen when captured values can be read.
+	 */
+	capture_state_t getCaptureState();
+
+	/**
+	 * @brief Get the number of values held for each captured channel.
+	 *        This value is only relevant once capture is armed.
+	 */
+	uint32_t getCaptureDepth();
+
+	/**
+	 * @brief Get the index of the trigger value in the values of a
+	 *        frozen capture.
+	 *
+	 * @param capture_index Index of the channel in the capture.
+	 */
+	uint32_t getCaptureTriggerIndex(uint8_t capture_index);
+
+	/**
+	 * @brief Copies raw values of a frozen capture in chronological order.
+	 *        Values can be converted using data.convert().
+	 *
+	 * @param capture_index Index of the channel in the capture.
+	 * @param start Index of first value to copy.
+	 * @param buffer Buffer to copy values to.
+	 * @param count Size of the buffer.
+	 *
+	 * @return Number of values copied, 0 if capture is not frozen.
+	 */
+	size_t readCapture(uint8_t capture_index, uint32_t start, uint16_t* buffer, size_t count);
+
+	/**
+	 * @brief Prints a frozen capture on the console, one line per
+	 *        value index: index relative to trigger, then converted
+	 *        value of each captured channel, separated by commas.
+	 *
+	 * @note  This function is slow, and must be called from the
+	 *        background task.
+	 *
+	 * @return 0 if capture was printed, -1 if capture is not frozen.
+	 */
+	int8_t printCapture();
+#endif
+
 
 	/////
 	// Accessor API
@@ -396,7 +1205,8 @@ public:
 	 * @note  When calling this function, it invalidates the buffer
 	 *        returned by a previous call to the same function.
 	 *        However, different channels buffers are independent
-	 *        from each other.
+	 *        from each other. Until then, the returned values are
+	 *        guaranteed not to be overwritten by new acquisitions.
 	 *
 	 * @note When using this functions, the user is responsible for data
 	 *       conversion. Use matching data.convert*() function
@@ -418,6 +1228,60 @@ public:
 	 */
 	uint16_t* getRawValues(uint8_t adc_num, uint8_t pin_num, uint32_t& number_of_values_acquired);
 
+	/**
+	 * @brief Function to access the acquired data for specified pin
+	 *        using a reader cursor obtained with data.registerCursor().
+	 *        See the shield channel version of this function for details.
+	 *
+	 * @param adc_num Number of the ADC from which to obtain values.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 * @param number_of_values_acquired Pass an uint32_t variable.
+	 *        This variable will be updated with the number of values that
+	 *        are present in the returned buffer.
+	 * @param cursor Cursor obtained from data.registerCursor().
+	 *
+	 * @return Pointer to a buffer in which the acquired values are stored.
+	 */
+	uint16_t* getRawValues(uint8_t adc_num, uint8_t pin_num, uint32_t& number_of_values_acquired, uint8_t cursor);
+
+	/**
+	 * @brief Function to access the acquired data for specified pin
+	 *        along with the time at which each value was acquired.
+	 *        See the shield channel version of this function for details.
+	 *
+	 * @param adc_num Number of the ADC from which to obtain values.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 * @param number_of_values_acquired Pass an uint32_t variable.
+	 *        This variable will be updated with the number of values that
+	 *        are present in the returned buffer.
+	 * @param timestamps Pass a const sample_timestamp_t* variable. This
+	 *        variable will be updated with a buffer holding the timestamp
+	 *        of each returned value.
+	 *
+	 * @return Pointer to a buffer in which the acquired values are stored.
+	 */
+	uint16_t* getRawValuesTimed(uint8_t adc_num, uint8_t pin_num, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps);
+
+	/**
+	 * @brief Register a new reader on the pin.
+	 *        See the shield channel version of this function for details.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Cursor number, or -1 if no cursor is available.
+	 */
+	int8_t registerCursor(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Release a cursor previously obtained with data.registerCursor().
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param cursor Cursor to release.
+	 */
+	void releaseCursor(uint8_t adc_num, uint8_t pin_num, uint8_t cursor);
+
 	/**
 	 * @brief Function to access the latest value available from a pin,
 	 *        expressed in the relevant unit for the data: Volts, Amperes, or
@@ -457,16 +1321,263 @@ public:
 	 *        facultative. If this parameter is provided, it will be updated
 	 *        to indicate information about data. Possible values for this
 	 *        parameter will be:
-	 *        - DATA_IS_OK if returned data is a newly acquired data,
+	 *        - DATA_IS_OK if returned data is a newly acquired data, i.e.
+	 *        the newest value acquired, even if older ones were lost on overrun,
 	 *        - DATA_IS_OLD if returned data has already been provided before
 	 *        (no new data available since latest time this function was called),
 	 *        - DATA_IS_MISSING if returned data is NO_VALUE.
+	 * @param sequence Pointer to a channel_sequence_t variable. This parameter
+	 *        is facultative. If this parameter is provided, it will be updated
+	 *        with the sequence number and age of the latest acquired value,
+	 *        as returned by data.getSequenceInfo().
 	 *
 	 * @return Latest acquired measure for the channel.
 	 *         If no value was acquired in this channel yet, return value is NO_VALUE.
 	 *
 	 */
-	float32_t getLatest(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid = nullptr);
+	float32_t getLatest(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid = nullptr, channel_sequence_t* sequence = nullptr);
+
+	/**
+	 * @brief Function to access the raw values acquired for specified
+	 *        pin between the two latest dispatches, without any copy.
+	 *        The returned view points directly to the DMA buffer: use
+	 *        view[i] to access the i-th value, i ranging from 0 to
+	 *        view.count-1.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *        The DataAPI module must have been started, either
+	 *        explicitly or by starting the Uninterruptible task.
+	 *
+	 * @note  To drop the dispatch copy and have the view remain
+	 *        valid for a whole period, call data.setDispatchCopy(false)
+	 *        before starting the module.
+	 *
+	 * @param adc_num Number of the ADC from which to obtain values.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 *
+	 * @return View on the acquired values. If view.count is 0,
+	 *         do not try to access the values.
+	 */
+	channel_view_t getRawView(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Function to obtain the number of values that have been
+	 *        lost for the specified pin because its buffer wrapped
+	 *        before they were read.
+	 *        See data.getOverrunCount(channel_t).
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Number of lost values since module was started.
+	 */
+	uint32_t getOverrunCount(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Function to obtain the number of values that have been
+	 *        lost by a reader cursor of the specified pin.
+	 *        See data.getOverrunCount(channel_t, uint8_t).
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param cursor Cursor obtained from data.registerCursor().
+	 *
+	 * @return Number of lost values since the cursor was registered.
+	 */
+	uint32_t getOverrunCount(uint8_t adc_num, uint8_t pin_num, uint8_t cursor);
+
+	/**
+	 * @brief Function to obtain the sequence number and age of the latest
+	 *        value acquired for the specified pin.
+	 *        See data.getSequenceInfo(channel_t, channel_sequence_t&).
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param sequence Output parameter: sequence number and age of the
+	 *        latest value. Both are 0 if no value was acquired yet.
+	 *
+	 * @return 0 if a value was acquired for the pin, -1 otherwise.
+	 */
+	int8_t getSequenceInfo(uint8_t adc_num, uint8_t pin_num, channel_sequence_t& sequence);
+
+	/**
+	 * @brief Function to access the latest pair of simultaneous values of
+	 *        two pins acquired by ADC 1 and ADC 2 in dual sampling mode,
+	 *        expressed in the relevant unit for the pins.
+	 *
+	 * @note  Pins must have the same rank on ADC 1 and ADC 2, and dual
+	 *        sampling must have been enabled using data.configureDualSampling().
+	 *
+	 * @param adc1_pin_num Number of the pin acquired by ADC 1.
+	 * @param adc2_pin_num Number of the pin acquired by ADC 2.
+	 * @param adc1_value Output parameter: latest value of ADC 1 pin.
+	 * @param adc2_value Output parameter: latest value of ADC 2 pin.
+	 *
+	 * @return 0 if a pair was available, -1 if pins are not paired
+	 *         or no value was acquired yet.
+	 */
+	int8_t peekPair(uint8_t adc1_pin_num, uint8_t adc2_pin_num, float32_t& adc1_value, float32_t& adc2_value);
+
+	/**
+	 * @brief Function to access the raw values of two pins acquired by
+	 *        ADC 1 and ADC 2 in dual sampling mode between the two latest
+	 *        dispatches, without any copy. Values at the same index in
+	 *        both views were acquired simultaneously.
+	 *
+	 * @param adc1_pin_num Number of the pin acquired by ADC 1.
+	 * @param adc2_pin_num Number of the pin acquired by ADC 2.
+	 * @param adc1_view Output parameter: view on ADC 1 pin values.
+	 * @param adc2_view Output parameter: view on ADC 2 pin values.
+	 *
+	 * @return 0 if views hold values, -1 otherwise.
+	 */
+	int8_t getPairedRawViews(uint8_t adc1_pin_num, uint8_t adc2_pin_num, channel_view_t& adc1_view, channel_view_t& adc2_view);
+
+	/**
+	 * @brief Function to apply a boxcar filter to the specified pin:
+	 *        each filter output is the average of a block of consecutive
+	 *        acquired values.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param length Number of values averaged, from 2 to 65535.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setBoxcarFilter(uint8_t adc_num, uint8_t pin_num, uint32_t length);
+
+	/**
+	 * @brief Function to apply a CIC decimation filter to the specified pin.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param order Number of stages of the filter, from 1 to 3.
+	 * @param decimation Decimation ratio. decimation^order must not
+	 *        exceed 65536.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setCicFilter(uint8_t adc_num, uint8_t pin_num, uint8_t order, uint32_t decimation);
+
+	/**
+	 * @brief Function to apply a first-order low-pass IIR filter to the
+	 *        specified pin.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param shift Smoothing factor, from 1 to 15.
+	 *
+	 * @return 0 if filter was set, -1 if parameters are invalid.
+	 */
+	int8_t setIirFilter(uint8_t adc_num, uint8_t pin_num, uint8_t shift);
+
+	/**
+	 * @brief Function to remove the filter applied to the specified pin.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 */
+	void disableFilter(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Function to obtain the latest output of the filter applied
+	 *        to the specified pin, converted to the relevant unit.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param dataValid Pointer to an uint8_t variable. This parameter is
+	 *        facultative. See data.getFiltered(channel) for details.
+	 *
+	 * @return Latest filter output. If filter did not produce an
+	 *         output yet, return value is NO_VALUE.
+	 */
+	float32_t getFiltered(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid = nullptr);
+
+	/**
+	 * @brief Function to enable running statistics on the specified pin:
+	 *        minimum, maximum, mean and RMS values are computed over
+	 *        consecutive windows of acquired values.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param window_length Number of values in a window, up to 65536,
+	 *        or 0 to disable statistics.
+	 *
+	 * @return 0 if statistics were configured, -1 if there was an error.
+	 */
+	int8_t setStatsWindow(uint8_t adc_num, uint8_t pin_num, uint32_t window_length);
+
+	/**
+	 * @brief Function to obtain the statistics of the latest completed
+	 *        window of the specified pin, as a consistent snapshot.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Statistics of the latest window. If no window was
+	 *         completed yet, count is 0 and values are NO_VALUE.
+	 */
+	channel_stats_t getStats(uint8_t adc_num, uint8_t pin_num);
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+	/**
+	 * @brief Function to add the specified pin to the capture.
+	 *
+	 * @note  This function can't be called before the pin is enabled,
+	 *        nor while capture is armed.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Index of the pin in the capture, to be used with
+	 *         data.readCapture(), or -1 if pin can't be captured.
+	 */
+	int8_t addCaptureChannel(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Function to trigger the capture when the specified pin
+	 *        crosses a level. See data.setCaptureLevelTrigger(channel)
+	 *        for details.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 * @param level Level to cross, in the relevant unit.
+	 * @param edge capture_trigger_rising or capture_trigger_falling.
+	 *
+	 * @return 0 if trigger was set, -1 otherwise.
+	 */
+	int8_t setCaptureLevelTrigger(uint8_t adc_num, uint8_t pin_num, float32_t level, capture_trigger_t edge);
+#endif
+
+	/**
+	 * @brief Function to read the latest injected conversion of the
+	 *        specified pin, converted to the relevant unit.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Latest injected value, or NO_VALUE if pin is not injected.
+	 */
+	float32_t readInjected(uint8_t adc_num, uint8_t pin_num);
+
+	/**
+	 * @brief Function to read the latest injected conversion of the
+	 *        specified pin as a raw 12-bit value.
+	 *
+	 * @param adc_num Number of the ADC.
+	 * @param pin_num Number of the pin.
+	 *
+	 * @return Latest injected raw value, or 0 if pin is not injected.
+	 */
+	uint16_t readInjectedRaw(uint8_t adc_num, uint8_t pin_num);
 
 	/**
 	 * @brief Use this function to convert values obtained using matching
@@ -483,6 +1594,40 @@ public:
 	 */
 	float32_t convert(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value);
 
+	/**
+	 * @brief Use this function to convert a whole buffer of values obtained
+	 *        using matching data.get*RawValues() function to relevant unit
+	 *        for the data: Volts, Amperes, or Degree Celcius. Conversion
+	 *        is done in one pass, which is much faster than calling
+	 *        data.convert() on each value.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC from which the values originate.
+	 * @param pin_num Number of the pin from which the values originate.
+	 * @param raw_values Buffer of raw values obtained from the channel.
+	 * @param values_count Number of values in the buffer.
+	 * @param converted_values Buffer able to hold at least values_count
+	 *        values, that will be filled with the converted values.
+	 */
+	void convertBuffer(uint8_t adc_num, uint8_t pin_num, const uint16_t* raw_values, size_t values_count, float32_t* converted_values);
+
+	/**
+	 * @brief Use this function to obtain the average of a buffer of values
+	 *        obtained using matching data.get*RawValues() function, in the
+	 *        relevant unit for the data: Volts, Amperes, or Degree Celcius.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC from which the values originate.
+	 * @param pin_num Number of the pin from which the values originate.
+	 * @param raw_values Buffer of raw values obtained from the channel.
+	 * @param values_count Number of values in the buffer.
+	 *
+	 * @return Average converted value, or 0 if values_count is 0.
+	 */
+	float32_t convertAverage(uint8_t adc_num, uint8_t pin_num, const uint16_t* raw_values, size_t values_count);
+
 	/**
 	 * @brief Use this function to tweak the conversion values for the
 	 *        channel if default values are not accurate enough.
@@ -499,25 +1644,193 @@ public:
 	 */
 	void setParameters(uint8_t adc_num, uint8_t pin_num, float32_t gain, float32_t offset);
 
+	/**
+	 * @brief Use this function to set a third-order polynomial conversion
+	 *        for the pin. See data.setPolynomialParameters(channel).
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *        The DataAPI module must not have been started, neither
+	 *        explicitly nor by starting the Uninterruptible task.
+	 *
+	 * @param adc_num Number of the ADC to set conversion values.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 * @param a0 Constant coefficient.
+	 * @param a1 First order coefficient.
+	 * @param a2 Second order coefficient.
+	 * @param a3 Third order coefficient.
+	 */
+	void setPolynomialParameters(uint8_t adc_num, uint8_t pin_num, float32_t a0, float32_t a1, float32_t a2, float32_t a3);
+
+	/**
+	 * @brief Use this function to set a lookup-table conversion for
+	 *        the pin. See data.setLookupTableParameters(channel).
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *        The DataAPI module must not have been started, neither
+	 *        explicitly nor by starting the Uninterruptible task.
+	 *
+	 * @param adc_num Number of the ADC to set conversion values.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 * @param anchors Converted values at evenly spaced raw values.
+	 * @param anchors_count Number of anchors, from 2 to 33.
+	 *
+	 * @return 0 if conversion was set, -1 otherwise.
+	 */
+	int8_t setLookupTableParameters(uint8_t adc_num, uint8_t pin_num, const float32_t* anchors, uint8_t anchors_count);
+
+	/**
+	 * @brief Use this function to convert values obtained using matching
+	 *        data.get*RawValues() function to relevant unit for the data,
+	 *        expressed in fixed-point Q15 format as a fraction of the
+	 *        pin full scale (see data.setFixedPointFullScale()).
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC from which the value originates.
+	 * @param pin_num Number of the pin from which the value originates.
+	 * @param raw_value Raw value obtained from the channel buffer.
+	 *
+	 * @return Converted value divided by full scale, in Q15 format.
+	 */
+	q15_t convertQ15(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value);
+
+	/**
+	 * @brief Same as data.convertQ15() with Q31 output format.
+	 *
+	 * @param adc_num Number of the ADC from which the value originates.
+	 * @param pin_num Number of the pin from which the value originates.
+	 * @param raw_value Raw value obtained from the channel buffer.
+	 *
+	 * @return Converted value divided by full scale, in Q31 format.
+	 */
+	q31_t convertQ31(uint8_t adc_num, uint8_t pin_num, uint16_t raw_value);
+
+	/**
+	 * @brief Function to access the latest value available from a pin,
+	 *        expressed in fixed-point Q15 format as a fraction of the
+	 *        pin full scale.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *        The DataAPI module must have been started, either
+	 *        explicitly or by starting the Uninterruptible task.
+	 *
+	 * @param adc_num Number of the ADC from which to obtain value.
+	 * @param pin_num Number of the pin from which to obtain values.
+	 * @param dataValid Pointer to an uint8_t variable. This parameter is
+	 *        facultative. If this parameter is provided, it will be updated
+	 *        to DATA_IS_OK if a value is available, or DATA_IS_MISSING
+	 *        otherwise, in which case returned value is 0.
+	 *
+	 * @return Latest available value from the given pin in Q15 format.
+	 */
+	q15_t peekQ15(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid = nullptr);
+
+	/**
+	 * @brief Use this function to set the full scale of the pin for
+	 *        fixed-point conversion, i.e. the value in the relevant unit
+	 *        that is represented by 1 in Q15 and Q31 formats.
+	 *
+	 * @note  This function can't be called before the pin is enabled.
+	 *
+	 * @param adc_num Number of the ADC to set full scale.
+	 * @param pin_num Number of the pin to set full scale.
+	 * @param full_scale Full scale, strictly positive.
+	 */
+	void setFixedPointFullScale(uint8_t adc_num, uint8_t pin_num, float32_t full_scale);
+
 
 private:
 	int8_t enableChannel(uint8_t adc_num, uint8_t channel_num);
-	uint16_t* getChannelRawValues(uint8_t adc_num, uint8_t channel_num, uint32_t& number_of_values_acquired);
-	float32_t peekChannel(uint8_t adc_num, uint8_t channel_num);
-	float32_t getChannelLatest(uint8_t adc_num, uint8_t channel_num, uint8_t* dataValid = nullptr);
+	channel_handle_t buildChannelHandle(uint8_t adc_num, uint8_t channel_num);
+	uint16_t* getChannelRawValues(const channel_handle_t& handle, uint32_t& number_of_values_acquired, uint8_t cursor = 0);
+	uint16_t* getChannelRawValuesTimed(const channel_handle_t& handle, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps);
+	int8_t registerChannelCursor(const channel_handle_t& handle);
+	void releaseChannelCursor(const channel_handle_t& handle, uint8_t cursor);
+	float32_t peekChannel(const channel_handle_t& handle);
+	float32_t getChannelLatest(const channel_handle_t& handle, uint8_t* dataValid = nullptr, channel_sequence_t* sequence = nullptr);
+	channel_view_t getChannelRawView(const channel_handle_t& handle);
+	uint32_t getChannelOverrunCount(const channel_handle_t& handle, uint8_t cursor = 0);
+	int8_t getChannelSequenceInfo(const channel_handle_t& handle, channel_sequence_t& sequence);
+	int8_t peekChannelPair(const channel_handle_t& handle_a, const channel_handle_t& handle_b, float32_t& value_a, float32_t& value_b);
+	int8_t getChannelPairRawViews(const channel_handle_t& handle_a, const channel_handle_t& handle_b, channel_view_t& view_a, channel_view_t& view_b);
+	q15_t peekChannelQ15(const channel_handle_t& handle, uint8_t* dataValid = nullptr);
+	int8_t setChannelFilter(const channel_handle_t& handle, filter_type_t type, uint32_t param1, uint32_t param2 = 0);
+	float32_t getChannelFiltered(const channel_handle_t& handle, uint8_t* dataValid = nullptr);
+	int8_t setChannelStatsWindow(const channel_handle_t& handle, uint32_t window_length);
+	channel_stats_t getChannelStats(const channel_handle_t& handle);
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+	int8_t addChannelToCapture(const channel_handle_t& handle);
+	int8_t setChannelCaptureLevelTrigger(const channel_handle_t& handle, float32_t level, capture_trigger_t edge);
+#endif
+	int8_t enableInjectedChannel(uint8_t adc_num, uint8_t channel_num);
+	injected_handle_t buildInjectedHandle(uint8_t adc_num, uint8_t channel_num);
+	float32_t readChannelInjected(const injected_handle_t& handle);
+	int8_t checkOversamplingTiming(uint8_t adc_num, uint32_t ratio, adc_ovs_mode_t mode);
 	uint8_t getChannelRank(uint8_t adc_num, uint8_t channel_num);
-	uint8_t getChannelNumber(uint8_t adc_num, uint8_t twist_pin);
+	static constexpr uint8_t getChannelNumber(uint8_t adc_num, uint8_t twist_pin)
+	{
+		return spin_adc_pins_get_channel_number(adc_num, twist_pin);
+	}
 
 private:
 	bool is_started = false;
 	uint8_t channels_ranks[ADC_COUNT][CHANNELS_PER_ADC] = {0};
 	uint8_t current_rank[ADC_COUNT] = {0};
+	uint8_t injected_ranks[ADC_COUNT][CHANNELS_PER_ADC] = {0};
+	uint8_t injected_raw_shifts[ADC_COUNT] = {0};
+#ifdef CONFIG_SHIELD_TWIST
+	// Handles of shield channels, indexed by channel_t value
+	channel_handle_t channel_handles[SHIELD_CHANNELS_COUNT+1] = {0};
+	// Handles of injected shield channels, indexed by channel_t value
+	injected_handle_t injected_handles[SHIELD_CHANNELS_COUNT+1] = {0};
+#endif
 	DispatchMethod_t dispatch_method = DispatchMethod_t::on_dma_interrupt;
 	uint32_t repetition_count_between_dispatches = 0;
+	bool dispatch_copy = true;
+	bool dual_sampling = false;
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+	// Handles of captured channels, indexed by capture index
+	channel_handle_t capture_handles[CAPTURE_MAX_CHANNELS] = {0};
+#endif
 
 };
 
 
+/////
+// Inline pin accessors: the pin lookup is a constant table read,
+// which is folded at compile time when the pin is a constant.
+
+inline float32_t DataAPI::peek(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		return NO_VALUE;
+	}
+
+	return this->peekChannel(this->buildChannelHandle(adc_num, channel_num));
+}
+
+inline float32_t DataAPI::getLatest(uint8_t adc_num, uint8_t pin_num, uint8_t* dataValid, channel_sequence_t* sequence)
+{
+	uint8_t channel_num = this->getChannelNumber(adc_num, pin_num);
+	if (channel_num == 0)
+	{
+		if (dataValid != nullptr)
+		{
+			*dataValid = DATA_IS_MISSING;
+		}
+		if (sequence != nullptr)
+		{
+			*sequence = channel_sequence_t{0, 0};
+		}
+		return NO_VALUE;
+	}
+
+	return this->getChannelLatest(this->buildChannelHandle(adc_num, channel_num), dataValid, sequence);
+}
+
+
 /////
 // Public object to interact with the class
 
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Data API on-target benchmark, measured with the DWT
+ *         cycle counter with interrupts locked. Dispatch of a
+ *         DMA block to the per-channel flat rings is compared
+ *         with the former dispatch to double buffers reached
+ *         through pointer tables, one value at a time. Bulk
+ *         conversion of a buffer is compared with conversion
+ *         of each value of the buffer.
+ */
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// Current module private headers
+#include "data_dispatch.h"
+#include "data_conversion.h"
+
+
+/////
+// Local variables and constants
+
+#define CHANNELS_BUFFERS_SIZE CONFIG_OWNTECH_DATA_API_CHANNEL_BUFFER_SIZE
+#define MAX_CHANNELS_PER_ADC  CONFIG_OWNTECH_DATA_API_MAX_CHANNELS_PER_ADC
+
+#define BENCHMARK_CHANNELS   MIN(4, MAX_CHANNELS_PER_ADC)
+#define BENCHMARK_MAX_BLOCK  MIN(16, CHANNELS_BUFFERS_SIZE) // Values per channel
+#define BENCHMARK_ITERATIONS 1000
+
+// Conversion uses ADC 1 channel 1, on buffers of typical
+// size for a control task reading values in task dispatch.
+#define BENCHMARK_ADC_NUM          1
+#define BENCHMARK_CHANNEL_NUM      1
+#define BENCHMARK_CONVERSION_SIZE  32
+
+#define STACKSIZE 1024
+#define PRIORITY  5 // Same as background tasks
+
+typedef void (*benchmark_copy_t)(uint16_t* dma_buffer, size_t dma_buffer_size, uint8_t sequence_size);
+
+static uint16_t dma_block[BENCHMARK_CHANNELS*BENCHMARK_MAX_BLOCK];
+
+// Former layout: double buffers of each ADC channel reached through
+// pointer tables, adc_channel_buffers[adc][channel][buffer][value].
+static uint16_t    legacy_storage[BENCHMARK_CHANNELS][2][CHANNELS_BUFFERS_SIZE];
+static uint16_t*   legacy_channel_buffers[BENCHMARK_CHANNELS][2];
+static uint16_t**  legacy_adc_buffers[BENCHMARK_CHANNELS];
+static uint16_t*** legacy_buffers[1] = {legacy_adc_buffers};
+static uint32_t    legacy_counts[BENCHMARK_CHANNELS];
+static uint32_t*   legacy_data_count[1] = {legacy_counts};
+static uint8_t     legacy_current[BENCHMARK_CHANNELS];
+static uint8_t*    legacy_current_buffer[1] = {legacy_current};
+static size_t      legacy_next_dma_index = 0;
+
+static uint16_t  raw_values[BENCHMARK_CONVERSION_SIZE];
+static float32_t converted_values[BENCHMARK_CONVERSION_SIZE];
+
+static void _data_benchmark_thread(void*, void*, void*);
+
+K_THREAD_DEFINE(data_benchmark_id, STACKSIZE, _data_benchmark_thread, NULL, NULL, NULL,
+                PRIORITY, 0, 1000);
+
+
+/////
+// Private functions
+
+/**
+ * Former dispatch loop, in task mode.
+ */
+static void _data_benchmark_legacy_copy(uint16_t* dma_buffer, size_t dma_buffer_size, uint8_t sequence_size)
+{
+	for (size_t dma_index = 0 ; dma_index < dma_buffer_size ; dma_index++)
+	{
+		size_t dma_buffer_index = legacy_next_dma_index;
+		if (legacy_next_dma_index < dma_buffer_size-1)
+		{
+			legacy_next_dma_index++;
+		}
+		else
+		{
+			legacy_next_dma_index = 0;
+		}
+
+		size_t    channel_index = dma_buffer_index % sequence_size;
+		uint8_t   active_index  = legacy_current_buffer[0][channel_index];
+		uint16_t* active_buffer = legacy_buffers[0][channel_index][active_index];
+		uint32_t  current_count = legacy_data_count[0][channel_index];
+
+		active_buffer[current_count] = dma_buffer[dma_buffer_index];
+
+		if (current_count < CHANNELS_BUFFERS_SIZE)
+		{
+			legacy_data_count[0][channel_index]++;
+		}
+	}
+}
+
+/**
+ * Former reader buffer swap, which empties the written buffer.
+ */
+static void _data_benchmark_legacy_swap(uint8_t sequence_size)
+{
+	for (uint8_t channel_index = 0 ; channel_index < sequence_size ; channel_index++)
+	{
+		legacy_current[channel_index] = (legacy_current[channel_index] == 0) ? 1 : 0;
+		legacy_counts[channel_index]  = 0;
+	}
+}
+
+/**
+ * Run a copy function on DMA blocks, and get the total cycles count.
+ */
+static uint32_t _data_benchmark_run_copy(benchmark_copy_t copy, size_t block_values, uint8_t sequence_size)
+{
+	uint32_t total_cycles = 0;
+
+	for (uint32_t iteration = 0 ; iteration < BENCHMARK_ITERATIONS ; iteration++)
+	{
+		unsigned int key = irq_lock();
+		uint32_t start = DWT->CYCCNT;
+
+		copy(dma_block, block_values*sequence_size, sequence_size);
+
+		total_cycles += DWT->CYCCNT - start;
+		irq_unlock(key);
+
+		// Legacy buffers must be emptied before they overflow,
+		// as the control task would do by reading them.
+		_data_benchmark_legacy_swap(sequence_size);
+	}
+
+	return total_cycles;
+}
+
+static void _data_benchmark_print(const char* name, uint32_t total_cycles, uint32_t values_count)
+{
+	// Cycles per value, with two decimals
+	uint32_t centi_cycles = (uint32_t)(((uint64_t)total_cycles * 100) / values_count);
+
+	printk("Data benchmark: %s: %u.%02u cycles per value\n",
+	       name,
+	       centi_cycles / 100,
+	       centi_cycles % 100
+	      );
+}
+
+static void _data_benchmark_dispatch()
+{
+	uint8_t sequence_size = BENCHMARK_CHANNELS;
+
+	for (uint8_t channel_index = 0 ; channel_index < BENCHMARK_CHANNELS ; channel_index++)
+	{
+		legacy_adc_buffers[channel_index] = legacy_channel_buffers[channel_index];
+		legacy_channel_buffers[channel_index][0] = legacy_storage[channel_index][0];
+		legacy_channel_buffers[channel_index][1] = legacy_storage[channel_index][1];
+	}
+
+	for (size_t i = 0 ; i < BENCHMARK_CHANNELS*BENCHMARK_MAX_BLOCK ; i++)
+	{
+		dma_block[i] = (uint16_t)((i * 37) & 0x0FFF);
+	}
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+	printk("Data benchmark: dispatch of %u channels, timestamps enabled\n", sequence_size);
+#else
+	printk("Data benchmark: dispatch of %u channels\n", sequence_size);
+#endif
+
+	// One value per channel matches interrupt dispatch,
+	// larger blocks match task dispatch.
+	for (size_t block_values = 1 ; block_values <= BENCHMARK_MAX_BLOCK ; block_values *= 4)
+	{
+		uint32_t values_count = BENCHMARK_ITERATIONS * block_values * sequence_size;
+
+		printk("Data benchmark: %u values per channel per dispatch\n", (uint32_t)block_values);
+
+		legacy_next_dma_index = 0;
+		uint32_t legacy_cycles = _data_benchmark_run_copy(_data_benchmark_legacy_copy, block_values, sequence_size);
+		_data_benchmark_print("legacy double buffers", legacy_cycles, values_count);
+
+		uint32_t ring_cycles = _data_benchmark_run_copy(data_dispatch_benchmark_copy, block_values, sequence_size);
+		_data_benchmark_print("flat rings", ring_cycles, values_count);
+	}
+
+	data_dispatch_benchmark_reset(sequence_size);
+}
+
+static void _data_benchmark_convert_values(const uint16_t* raw, size_t values_count, float32_t* converted)
+{
+	for (size_t i = 0 ; i < values_count ; i++)
+	{
+		converted[i] = data_conversion_convert_raw_value(BENCHMARK_ADC_NUM, BENCHMARK_CHANNEL_NUM, raw[i]);
+	}
+}
+
+static void _data_benchmark_convert_buffer(const uint16_t* raw, size_t values_count, float32_t* converted)
+{
+	data_conversion_convert_raw_buffer(BENCHMARK_ADC_NUM, BENCHMARK_CHANNEL_NUM, raw, values_count, converted);
+}
+
+/**
+ * Run a conversion function on a buffer, and get the total cycles count.
+ */
+static uint32_t _data_benchmark_run_conversion(void (*convert)(const uint16_t*, size_t, float32_t*))
+{
+	uint32_t total_cycles = 0;
+
+	for (uint32_t iteration = 0 ; iteration < BENCHMARK_ITERATIONS ; iteration++)
+	{
+		unsigned int key = irq_lock();
+		uint32_t start = DWT->CYCCNT;
+
+		convert(raw_values, BENCHMARK_CONVERSION_SIZE, converted_values);
+
+		total_cycles += DWT->CYCCNT - start;
+		irq_unlock(key);
+	}
+
+	return total_cycles;
+}
+
+static void _data_benchmark_conversion()
+{
+	uint32_t values_count = BENCHMARK_ITERATIONS * BENCHMARK_CONVERSION_SIZE;
+
+	for (size_t i = 0 ; i < BENCHMARK_CONVERSION_SIZE ; i++)
+	{
+		raw_values[i] = (uint16_t)((i * 131) & 0x0FFF);
+	}
+
+	printk("Data benchmark: conversion of %u values\n", BENCHMARK_CONVERSION_SIZE);
+
+	data_conversion_set_conversion_parameters_linear(BENCHMARK_ADC_NUM, BENCHMARK_CHANNEL_NUM, 0.0125f, -25.f);
+	_data_benchmark_print("linear, per value", _data_benchmark_run_conversion(_data_benchmark_convert_values), values_count);
+	_data_benchmark_print("linear, buffer", _data_benchmark_run_conversion(_data_benchmark_convert_buffer), values_count);
+
+	data_conversion_set_conversion_parameters_poly3(BENCHMARK_ADC_NUM, BENCHMARK_CHANNEL_NUM, -25.f, 0.0125f, 1e-7f, -1e-11f);
+	_data_benchmark_print("poly3, per value", _data_benchmark_run_conversion(_data_benchmark_convert_values), values_count);
+	_data_benchmark_print("poly3, buffer", _data_benchmark_run_conversion(_data_benchmark_convert_buffer), values_count);
+
+	data_conversion_benchmark_reset(BENCHMARK_ADC_NUM, BENCHMARK_CHANNEL_NUM);
+}
+
+static void _data_benchmark_thread(void*, void*, void*)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	_data_benchmark_dispatch();
+	_data_benchmark_conversion();
+
+	printk("Data benchmark: done\n");
+}
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// OwnTech API
+#include "adc.h"
+
+// Current file header
+#include "data_capture.h"
+
+
+/////
+// Local variables
+
+#define CAPTURE_BUFFER_SIZE  CONFIG_OWNTECH_DATA_API_CAPTURE_BUFFER_SIZE
+#define MAX_CHANNELS_PER_ADC CONFIG_OWNTECH_DATA_API_MAX_CHANNELS_PER_ADC
+
+typedef struct
+{
+	uint8_t   adc_index;
+	uint8_t   channel_index;
+	uint16_t* buffer;       // Part of the capture buffer dedicated to this slot
+	uint32_t  write_index;  // Index of next value to write
+	uint32_t  filled;       // Number of values held, saturated at depth
+	uint32_t  position;     // Number of values pushed since capture was armed
+	bool      completed;    // All post-trigger values have been recorded
+} capture_slot_t;
+
+// Capture buffer, shared between all captured channels
+static uint16_t capture_buffer[CAPTURE_BUFFER_SIZE];
+
+static capture_slot_t capture_slots[CAPTURE_MAX_CHANNELS];
+static uint8_t        capture_channels_count = 0;
+
+// Slot of each ADC channel: slot index + 1, or 0 if not captured
+static uint8_t capture_slots_map[ADC_COUNT][MAX_CHANNELS_PER_ADC] = {0};
+
+// Buffer split
+static uint32_t capture_depth       = 0;
+static uint32_t pre_trigger_count   = 0;
+static uint32_t post_trigger_count  = 0;
+static uint8_t  completed_slots     = 0;
+
+// Position at which all slots stop recording once triggered. Positions
+// are counted in values pushed since capture was armed: as captured
+// channels are acquired on the same trigger, values of different slots
+// with the same position are simultaneous.
+static uint32_t stop_position = 0;
+
+// Trigger configuration
+static capture_trigger_t trigger_source = capture_trigger_software;
+static uint8_t           trigger_slot   = 0;
+static uint16_t          trigger_level  = 0;
+static uint16_t          previous_value = 0;
+
+static volatile capture_state_t capture_state = capture_idle;
+
+
+/////
+// Private functions
+
+/**
+ * Once triggered, check if a slot reached the stop position.
+ * Values recorded past it, which belong to a block dispatched
+ * before the trigger was detected, are discarded.
+ * Must be called with interrupts locked.
+ */
+static void _data_capture_complete_slot(capture_slot_t* capture_slot)
+{
+	int32_t excess = (int32_t)(capture_slot->position - stop_position);
+	if (excess < 0)
+		return;
+
+	if (excess > 0)
+	{
+		uint32_t discarded = (uint32_t)excess;
+		if (discarded > capture_slot->filled)
+		{
+			discarded = capture_slot->filled;
+		}
+
+		capture_slot->write_index = (capture_slot->write_index + capture_depth - discarded) % capture_depth;
+		capture_slot->filled     -= discarded;
+		capture_slot->position    = stop_position;
+	}
+
+	if (capture_slot->completed == false)
+	{
+		capture_slot->completed = true;
+		completed_slots++;
+		if (completed_slots == capture_channels_count)
+		{
+			capture_state = capture_frozen;
+		}
+	}
+}
+
+/**
+ * Switch to triggered state. Must be called with interrupts locked.
+ *
+ * @param trigger_position Position of the first post-trigger value.
+ */
+static void _data_capture_trigger(uint32_t trigger_position)
+{
+	stop_position   = trigger_position + post_trigger_count;
+	completed_slots = 0;
+	capture_state   = capture_triggered;
+
+	for (uint8_t slot = 0 ; slot < capture_channels_count ; slot++)
+	{
+		_data_capture_complete_slot(&capture_slots[slot]);
+	}
+}
+
+/**
+ * Get the position of the next value to be acquired, for
+ * events that are not related to a specific value. Slots
+ * behind the most advanced one have blocks left to push,
+ * which were acquired before the event.
+ * Must be called with interrupts locked.
+ */
+static uint32_t _data_capture_get_current_position()
+{
+	uint32_t position = 0;
+	for (uint8_t slot = 0 ; slot < capture_channels_count ; slot++)
+	{
+		if ((int32_t)(capture_slots[slot].position - position) > 0)
+		{
+			position = capture_slots[slot].position;
+		}
+	}
+
+	return position;
+}
+
+__STATIC_FORCEINLINE bool _data_capture_is_crossing(uint16_t previous, uint16_t value)
+{
+	if (trigger_source == capture_trigger_rising)
+	{
+		return (previous < trigger_level) && (value >= trigger_level);
+	}
+	else
+	{
+		return (previous > trigger_level) && (value <= trigger_level);
+	}
+}
+
+
+/////
+// Public API
+
+int8_t data_capture_add_channel(uint8_t adc_number, uint8_t channel_rank)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
+
+	if ( (capture_state == capture_armed) || (capture_state == capture_triggered) )
+		return -1;
+
+	if (capture_slots_map[adc_index][channel_index] != 0)
+		return capture_slots_map[adc_index][channel_index] - 1;
+
+	if (capture_channels_count == CAPTURE_MAX_CHANNELS)
+		return -1;
+
+	uint8_t slot = capture_channels_count;
+	capture_slots[slot].adc_index     = adc_index;
+	capture_slots[slot].channel_index = channel_index;
+	capture_slots_map[adc_index][channel_index] = slot + 1;
+	capture_channels_count++;
+
+	// Buffer split changes: previous capture is lost
+	capture_state = capture_idle;
+
+	return slot;
+}
+
+void data_capture_clear_channels()
+{
+	data_capture_abort();
+
+	for (uint8_t slot = 0 ; slot < capture_channels_count ; slot++)
+	{
+		capture_slots_map[capture_slots[slot].adc_index][capture_slots[slot].channel_index] = 0;
+	}
+	capture_channels_count = 0;
+	capture_depth          = 0;
+}
+
+uint8_t data_capture_get_channels_count()
+{
+	return capture_channels_count;
+}
+
+int8_t data_capture_set_trigger(capture_trigger_t trigger, uint8_t slot, uint16_t raw_level)
+{
+	if ( (capture_state == capture_armed) || (capture_state == capture_triggered) )
+		return -1;
+
+	if ( (trigger == capture_trigger_rising) || (trigger == capture_trigger_falling) )
+	{
+		if (slot >= capture_channels_count)
+			return -1;
+
+		trigger_slot  = slot;
+		trigger_level = raw_level;
+	}
+
+	trigger_source = trigger;
+
+	return 0;
+}
+
+int8_t data_capture_arm(uint32_t pre_trigger)
+{
+	if (capture_channels_count == 0)
+		return -1;
+
+	uint32_t depth = CAPTURE_BUFFER_SIZE / capture_channels_count;
+	if (pre_trigger > depth)
+		return -1;
+
+	unsigned int key = irq_lock();
+
+	capture_depth      = depth;
+	pre_trigger_count  = pre_trigger;
+	post_trigger_count = depth - pre_trigger;
+	completed_slots    = 0;
+
+	for (uint8_t slot = 0 ; slot < capture_channels_count ; slot++)
+	{
+		capture_slots[slot].buffer      = &capture_buffer[slot*depth];
+		capture_slots[slot].write_index = 0;
+		capture_slots[slot].filled      = 0;
+		capture_slots[slot].position    = 0;
+		capture_slots[slot].completed   = false;
+	}
+
+	// First value never triggers a level crossing
+	if (trigger_source == capture_trigger_rising)
+	{
+		previous_value = UINT16_MAX;
+	}
+	else
+	{
+		previous_value = 0;
+	}
+
+	capture_state = capture_armed;
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void data_capture_abort()
+{
+	unsigned int key = irq_lock();
+	capture_state = capture_idle;
+	irq_unlock(key);
+}
+
+void data_capture_notify_event(capture_trigger_t event)
+{
+	if ( (event != capture_trigger_software) && (event != trigger_source) )
+		return;
+
+	unsigned int key = irq_lock();
+	if (capture_state == capture_armed)
+	{
+		_data_capture_trigger(_data_capture_get_current_position());
+	}
+	irq_unlock(key);
+}
+
+capture_state_t data_capture_get_state()
+{
+	return capture_state;
+}
+
+uint32_t data_capture_get_depth()
+{
+	return capture_depth;
+}
+
+uint32_t data_capture_get_count(uint8_t slot)
+{
+	if (slot >= capture_channels_count)
+		return 0;
+
+	return capture_slots[slot].filled;
+}
+
+uint32_t data_capture_get_trigger_index(uint8_t slot)
+{
+	if ( (slot >= capture_channels_count) || (capture_state != capture_frozen) )
+		return 0;
+
+	// Once frozen, exactly post-trigger values were recorded after trigger
+	uint32_t filled = capture_slots[slot].filled;
+	return (filled > post_trigger_count) ? filled - post_trigger_count : 0;
+}
+
+size_t data_capture_read(uint8_t slot, uint32_t start, uint16_t* buffer, size_t count)
+{
+	if ( (slot >= capture_channels_count) || (capture_state != capture_frozen) )
+		return 0;
+
+	capture_slot_t* capture_slot = &capture_slots[slot];
+	if (start >= capture_slot->filled)
+		return 0;
+
+	if (count > capture_slot->filled - start)
+	{
+		count = capture_slot->filled - start;
+	}
+
+	// Oldest value is the filled-th value before write index
+	uint32_t read_index = (capture_slot->write_index + capture_depth - capture_slot->filled + start) % capture_depth;
+
+	for (size_t i = 0 ; i < count ; i++)
+	{
+		buffer[i] = capture_slot->buffer[read_index];
+		read_index++;
+		if (read_index == capture_depth)
+		{
+			read_index = 0;
+		}
+	}
+
+	return count;
+}
+
+int8_t data_capture_get_recording_slot(uint8_t adc_index, uint8_t channel_index)
+{
+	capture_state_t state = capture_state;
+	if ( (state != capture_armed) && (state != capture_triggered) )
+		return -1;
+
+	return capture_slots_map[adc_index][channel_index] - 1;
+}
+
+void data_capture_push(uint8_t         slot,
+                       const uint16_t* dma_buffer,
+                       size_t          dma_buffer_size,
+                       size_t          dma_index,
+                       size_t          stride,
+                       size_t          values_count)
+{
+	capture_slot_t* capture_slot = &capture_slots[slot];
+	uint16_t*       buffer       = capture_slot->buffer;
+	uint32_t        write_index  = capture_slot->write_index;
+	uint32_t        filled       = capture_slot->filled;
+	uint32_t        position     = capture_slot->position;
+
+	size_t i = 0;
+
+	// While armed, the trigger channel looks for a level crossing
+	// before recording each value, so that the trigger value is
+	// the first post-trigger value.
+	if ( (capture_state == capture_armed) && (slot == trigger_slot) &&
+	     ( (trigger_source == capture_trigger_rising) || (trigger_source == capture_trigger_falling) ) )
+	{
+		uint16_t previous = previous_value;
+		for ( ; i < values_count ; i++)
+		{
+			uint16_t value = dma_buffer[dma_index];
+
+			if ( (_data_capture_is_crossing(previous, value) == true) && (filled >= pre_trigger_count) )
+			{
+				// Trigger position is shared by all slots: those that
+				// already recorded this block discard values past the
+				// stop position, others stop recording at it.
+				unsigned int key = irq_lock();
+				capture_slot->write_index = write_index;
+				capture_slot->filled      = filled;
+				capture_slot->position    = position + i;
+				if (capture_state == capture_armed)
+				{
+					_data_capture_trigger(position + i);
+				}
+				irq_unlock(key);
+				break;
+			}
+			previous = value;
+
+			buffer[write_index] = value;
+			write_index++;
+			if (write_index == capture_depth)
+			{
+				write_index = 0;
+			}
+			if (filled < capture_depth)
+			{
+				filled++;
+			}
+
+			dma_index += stride;
+			if (dma_index >= dma_buffer_size)
+			{
+				dma_index -= dma_buffer_size;
+			}
+		}
+		previous_value = previous;
+		position += i;
+	}
+
+	// Once triggered, record remaining values up to the stop position
+	size_t record_count = values_count - i;
+	capture_state_t state = capture_state;
+	if ( (state == capture_triggered) || (state == capture_frozen) )
+	{
+		int32_t to_stop = (int32_t)(stop_position - position);
+		if (to_stop <= 0)
+		{
+			record_count = 0;
+		}
+		else if (record_count > (uint32_t)to_stop)
+		{
+			record_count = to_stop;
+		}
+	}
+
+	for (size_t j = 0 ; j < record_count ; j++)
+	{
+		buffer[write_index] = dma_buffer[dma_index];
+		write_index++;
+		if (write_index == capture_depth)
+		{
+			write_index = 0;
+		}
+
+		dma_index += stride;
+		if (dma_index >= dma_buffer_size)
+		{
+			dma_index -= dma_buffer_size;
+		}
+	}
+
+	filled += record_count;
+	if (filled > capture_depth)
+	{
+		filled = capture_depth;
+	}
+
+	// Trigger may have occurred while recording: in that case,
+	// values past the stop position are discarded.
+	unsigned int key = irq_lock();
+	capture_slot->write_index = write_index;
+	capture_slot->filled      = filled;
+	capture_slot->position    = position + record_count;
+	if ( (capture_state == capture_triggered) || (capture_state == capture_frozen) )
+	{
+		_data_capture_complete_slot(capture_slot);
+	}
+	irq_unlock(key);
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Triggered capture of channel values, similar to an
+ *         oscilloscope single acquisition. Once armed, values of
+ *         captured channels are continuously recorded by dispatch
+ *         in a statically allocated buffer. When the trigger occurs,
+ *         recording goes on for the post-trigger part of the buffer,
+ *         then stops: the buffer is frozen and can be read at leisure.
+ *
+ *         Capture buffer is evenly shared between captured channels.
+ *         Trigger is recorded as a position in the values acquired
+ *         since capture was armed, and all channels stop recording
+ *         at the same position: channels acquired on the same trigger
+ *         are aligned value by value, whatever the order in which
+ *         they are dispatched.
+ */
+
+#ifndef DATA_CAPTURE_H_
+#define DATA_CAPTURE_H_
+
+
+// Stdlib
+#include <stdint.h>
+#include <stddef.h>
+
+
+/////
+// Type definitions
+
+typedef enum : uint8_t
+{
+	capture_idle = 0,  // Not recording
+	capture_armed,     // Recording, waiting for trigger
+	capture_triggered, // Recording post-trigger values
+	capture_frozen     // Done, buffer can be read
+} capture_state_t;
+
+typedef enum : uint8_t
+{
+	capture_trigger_software = 0,  // Only data.triggerCapture()
+	capture_trigger_rising,        // Level crossing, rising edge
+	capture_trigger_falling,       // Level crossing, falling edge
+	capture_trigger_safety         // Safety API fault reaction
+} capture_trigger_t;
+
+static const uint8_t CAPTURE_MAX_CHANNELS = 4;
+
+
+/////
+// API
+
+/**
+ * @brief Add a channel to the capture.
+ *
+ * @param adc_number Number of the ADC.
+ * @param channel_rank Rank of the channel in the ADC sequence.
+ *
+ * @return Index of the channel in the capture, or -1 if capture
+ *         is currently recording, or all capture slots are used.
+ *         If channel is already captured, its index is returned.
+ */
+int8_t data_capture_add_channel(uint8_t adc_number, uint8_t channel_rank);
+
+/**
+ * @brief Remove all channels from the capture, and reset capture
+ *        state to idle.
+ */
+void data_capture_clear_channels();
+
+/**
+ * @brief Get the number of captured channels.
+ */
+uint8_t data_capture_get_channels_count();
+
+/**
+ * @brief Configure the capture trigger.
+ *
+ * @param trigger Trigger source.
+ * @param slot For level triggers, index of the captured
+ *        channel the level applies to. Ignored otherwise.
+ * @param raw_level For level triggers, raw value to cross.
+ *        Ignored otherwise.
+ *
+ * @return 0 if trigger was set, -1 if capture is currently
+ *         recording or slot is invalid.
+ */
+int8_t data_capture_set_trigger(capture_trigger_t trigger, uint8_t slot, uint16_t raw_level);
+
+/**
+ * @brief Start recording. Level triggers are only considered once
+ *        pre-trigger part of the buffer is full. Software and safety
+ *        events are always accepted: in that case, pre-trigger
+ *        history may be shorter than requested.
+ *
+ * @param pre_trigger_count Number of values of each channel to
+ *        keep before trigger. Must not exceed capture depth.
+ *
+ * @return 0 if capture was armed, -1 if no channel is captured
+ *         or pre-trigger count exceeds capture depth.
+ */
+int8_t data_capture_arm(uint32_t pre_trigger_count);
+
+/**
+ * @brief Stop recording and return to idle state.
+ */
+void data_capture_abort();
+
+/**
+ * @brief Notify an event to the capture engine. Capture is
+ *        triggered if it is armed and if event is either a
+ *        software event or the configured trigger source.
+ *        This function can be called from any context.
+ *
+ * @param event Type of event.
+ */
+void data_capture_notify_event(capture_trigger_t event);
+
+/**
+ * @brief Get the current capture state.
+ */
+capture_state_t data_capture_get_state();
+
+/**
+ * @brief Get the capture depth, i.e. the maximum number of
+ *        values held for each captured channel.
+ */
+uint32_t data_capture_get_depth();
+
+/**
+ * @brief Get the number of values held for a captured channel.
+ */
+uint32_t data_capture_get_count(uint8_t slot);
+
+/**
+ * @brief Get the index of the trigger value in the captured
+ *        values of a channel, in chronological order.
+ *        Only relevant when capture is frozen.
+ */
+uint32_t data_capture_get_trigger_index(uint8_t slot);
+
+/**
+ * @brief Copy captured values of a channel in chronological order.
+ *        This is only allowed when capture is frozen.
+ *
+ * @param slot Index of the captured channel.
+ * @param start Index of first value to copy.
+ * @param buffer Buffer to copy values to.
+ * @param count Maximum number of values to copy.
+ *
+ * @return Number of values copied.
+ */
+size_t data_capture_read(uint8_t slot, uint32_t start, uint16_t* buffer, size_t count);
+
+/**
+ * @brief Check if a channel values must be pushed to the capture.
+ *        This function is called by dispatch.
+ *
+ * @return Index of the captured channel, or -1 if channel is
+ *         not captured or capture is not recording.
+ */
+int8_t data_capture_get_recording_slot(uint8_t adc_index, uint8_t channel_index);
+
+/**
+ * @brief Push values of a captured channel from a DMA buffer.
+ *        This function is called by dispatch.
+ *
+ * @param slot Index of the captured channel.
+ * @param dma_buffer DMA buffer to read values from.
+ * @param dma_buffer_size Size of DMA buffer, at which read wraps.
+ * @param dma_index Index of first value of channel in DMA buffer.
+ * @param stride Distance between two values of the channel in DMA buffer.
+ * @param values_count Number of values to push.
+ */
+void data_capture_push(uint8_t         slot,
+                       const uint16_t* dma_buffer,
+                       size_t          dma_buffer_size,
+                       size_t          dma_index,
+                       size_t          stride,
+                       size_t          values_count);
+
+
+#endif // DATA_CAPTURE_H_
@@ -39,10 +39,50 @@
 /////
 // Local variables
 
-static const uint8_t max_parameters_count = 2;
+static const uint8_t max_parameters_count = 4;
 
 static conversion_type_t conversion_types[ADC_COUNT][CHANNELS_PER_ADC];
-static float32_t* conversion_parameters[ADC_COUNT][CHANNELS_PER_ADC];
+static float32_t conversion_parameters[ADC_COUNT][CHANNELS_PER_ADC][max_parameters_count];
+static bool conversion_parameters_set[ADC_COUNT][CHANNELS_PER_ADC];
+
+// Fixed-point conversion: converted values are expressed as a
+// fraction of a per-channel full scale, in Q31 format.
+// For linear conversion, value = raw*fixed_gain + fixed_offset
+// with gain and offset precomputed in Q31.
+static float32_t fixed_point_full_scale[ADC_COUNT][CHANNELS_PER_ADC];
+static bool      fixed_point_full_scale_set[ADC_COUNT][CHANNELS_PER_ADC];
+static int32_t   fixed_point_gain[ADC_COUNT][CHANNELS_PER_ADC];
+static int32_t   fixed_point_offset[ADC_COUNT][CHANNELS_PER_ADC];
+
+// Maximum raw value used to compute default full scale
+static const float32_t max_raw_value = 4095;
+
+// Raw values resolution: conversion parameters apply to 12-bit
+// raw values, while oversampled ADCs provide raw values with
+// additional bits. Gains are scaled by 2^-extra_bits on conversion.
+static uint8_t   raw_value_extra_bits[ADC_COUNT] = {0};
+static float32_t raw_value_scales[ADC_COUNT]     = {1, 1, 1, 1, 1};
+
+// Lookup tables, allocated to channels from a static pool.
+// Only anchors are stored in NVS: table is rebuilt from them.
+#define CONVERSION_LUT_COUNT CONFIG_OWNTECH_DATA_API_CONVERSION_LUT_COUNT
+#define NO_LUT 0xFF
+
+#if CONVERSION_LUT_COUNT > 0
+static float32_t conversion_luts[CONVERSION_LUT_COUNT][CONVERSION_LUT_SIZE];
+static float32_t lut_anchors[CONVERSION_LUT_COUNT][CONVERSION_LUT_MAX_ANCHORS];
+static uint8_t   lut_anchors_count[CONVERSION_LUT_COUNT] = {0};
+static bool      lut_allocated[CONVERSION_LUT_COUNT]     = {0};
+#endif
+
+// Lookup table used by each channel. Index is
+// only relevant when table pointer is not null.
+static uint8_t          lut_indexes[ADC_COUNT][CHANNELS_PER_ADC] = {0};
+static const float32_t* lut_tables[ADC_COUNT][CHANNELS_PER_ADC]  = {0};
+
+// Number of raw values converted at once by bulk conversion.
+// Intermediate buffer is held on stack.
+static const size_t bulk_conversion_chunk_size = 32;
 
 
 /////
@@ -59,11 +99,144 @@ static uint8_t _data_conversion_get_parameters_count(conversion_type_t type)
 			// Param 1 = offset
 			parameters_count = 2;
 			break;
+		case conversion_poly3:
+			// Param 0 to 3 = a0 to a3
+			parameters_count = 4;
+			break;
+		case conversion_lut:
+			// Parameters are the table anchors
+			parameters_count = 0;
+			break;
 	}
 
 	return parameters_count;
 }
 
+/**
+ * Evaluate the polynomial of a channel for a 12-bit raw value.
+ */
+__STATIC_INLINE float32_t _data_conversion_evaluate_poly3(uint8_t adc_index, uint8_t channel_index, float32_t raw_value)
+{
+	const float32_t* a = conversion_parameters[adc_index][channel_index];
+	return ((a[3]*raw_value + a[2])*raw_value + a[1])*raw_value + a[0];
+}
+
+/**
+ * Get the table entry of a channel for a raw value
+ * at current ADC resolution.
+ */
+__STATIC_INLINE float32_t _data_conversion_lookup(uint8_t adc_index, uint8_t channel_index, uint16_t raw_value)
+{
+	return lut_tables[adc_index][channel_index][(raw_value >> raw_value_extra_bits[adc_index]) & (CONVERSION_LUT_SIZE-1)];
+}
+
+/**
+ * Release the lookup table used by a channel, if any.
+ */
+static void _data_conversion_release_lut(uint8_t adc_index, uint8_t channel_index)
+{
+	if (lut_tables[adc_index][channel_index] == nullptr)
+		return;
+
+#if CONVERSION_LUT_COUNT > 0
+	lut_allocated[lut_indexes[adc_index][channel_index]] = false;
+#endif
+
+	lut_tables[adc_index][channel_index] = nullptr;
+}
+
+/**
+ * Get the largest absolute value a non-linear channel can output.
+ */
+static float32_t _data_conversion_get_max_value(uint8_t adc_index, uint8_t channel_index)
+{
+	float32_t max_value = 0;
+
+	for (uint32_t raw_value = 0 ; raw_value < CONVERSION_LUT_SIZE ; raw_value++)
+	{
+		float32_t value = 0;
+		if (conversion_types[adc_index][channel_index] == conversion_poly3)
+		{
+			value = _data_conversion_evaluate_poly3(adc_index, channel_index, raw_value);
+		}
+		else if (conversion_types[adc_index][channel_index] == conversion_lut)
+		{
+			value = lut_tables[adc_index][channel_index][raw_value];
+		}
+
+		if (fabsf(value) > max_value)
+		{
+			max_value = fabsf(value);
+		}
+	}
+
+	return max_value;
+}
+
+/**
+ * Get the gain of a linear channel, applicable
+ * to raw values at current ADC resolution.
+ */
+__STATIC_INLINE float32_t _data_conversion_get_raw_gain(uint8_t adc_index, uint8_t channel_index)
+{
+	return conversion_parameters[adc_index][channel_index][0] * raw_value_scales[adc_index];
+}
+
+static q31_t _data_conversion_float_to_q31(float32_t value)
+{
+	q31_t result;
+	arm_float_to_q31(&value, &result, 1);
+	return result;
+}
+
+/**
+ * Precompute the fixed-point parameters of a channel.
+ * Must be called each time the conversion parameters
+ * or the full scale of the channel are changed.
+ */
+static void _data_conversion_update_fixed_point_parameters(uint8_t adc_index, uint8_t channel_index)
+{
+	if (conversion_types[adc_index][channel_index] != conversion_linear)
+	{
+		// Non-linear conversions use floating-point conversion
+		if (fixed_point_full_scale_set[adc_index][channel_index] == false)
+		{
+			float32_t full_scale = _data_conversion_get_max_value(adc_index, channel_index);
+			if (full_scale == 0)
+			{
+				full_scale = 1;
+			}
+			fixed_point_full_scale[adc_index][channel_index] = full_scale;
+		}
+		return;
+	}
+
+	float32_t gain   = _data_conversion_get_raw_gain(adc_index, channel_index);
+	float32_t offset = conversion_parameters[adc_index][channel_index][1];
+
+	// Default full scale is the largest value the channel can output
+	if (fixed_point_full_scale_set[adc_index][channel_index] == false)
+	{
+		float32_t full_scale = fabsf(offset);
+		float32_t max_value  = fabsf(conversion_parameters[adc_index][channel_index][0]*max_raw_value + offset);
+		if (max_value > full_scale)
+		{
+			full_scale = max_value;
+		}
+		if (full_scale == 0)
+		{
+			full_scale = 1;
+		}
+
+		fixed_point_full_scale[adc_index][channel_index] = full_scale;
+	}
+
+	float32_t full_scale = fixed_point_full_scale[adc_index][channel_index];
+
+	fixed_point_gain[adc_index][channel_index]   = _data_conversion_float_to_q31(gain/full_scale);
+	fixed_point_offset[adc_index][channel_index] = _data_conversion_float_to_q31(offset/full_scale);
+}
+
 /////
 // Public Functions
 
@@ -74,10 +247,9 @@ void data_conversion_init()
 	{
 		for (int channel_index = 0 ; channel_index < CHANNELS_PER_ADC ; channel_index++)
 		{
-			if (conversion_parameters[adc_index][channel_index] == nullptr)
+			if (conversion_parameters_set[adc_index][channel_index] == false)
 			{
-				uint8_t param_count = _data_conversion_get_parameters_count(conversion_types[adc_index][channel_index]);
-				conversion_parameters[adc_index][channel_index] = (float32_t*)k_malloc(param_count*sizeof(float32_t));
+				conversion_parameters_set[adc_index][channel_index] = true;
 				switch(conversion_types[adc_index][channel_index])
 				{
 					case conversion_linear:
@@ -85,7 +257,10 @@ void data_conversion_init()
 						conversion_parameters[adc_index][channel_index][0]= 1;
 						conversion_parameters[adc_index][channel_index][1]= 0;
 						break;
+					default:
+						break;
 				}
+				_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
 			}
 		}
 	}
@@ -99,28 +274,306 @@ float32_t data_conversion_convert_raw_value(uint8_t adc_num, uint8_t channel_num
 	switch(conversion_types[adc_index][channel_index])
 	{
 		case conversion_linear:
-			return (raw_value*conversion_parameters[adc_index][channel_index][0]) + conversion_parameters[adc_index][channel_index][1];
+			return (raw_value*_data_conversion_get_raw_gain(adc_index, channel_index)) + conversion_parameters[adc_index][channel_index][1];
+			break;
+		case conversion_poly3:
+			return _data_conversion_evaluate_poly3(adc_index, channel_index, raw_value*raw_value_scales[adc_index]);
+			break;
+		case conversion_lut:
+			return _data_conversion_lookup(adc_index, channel_index, raw_value);
 			break;
 	}
 
 	return 0;
 }
 
-void data_conversion_set_conversion_parameters_linear(uint8_t adc_num, uint8_t channel_num, float32_t gain, float32_t offset)
+float32_t data_conversion_convert_fractional_raw_value(uint8_t adc_num, uint8_t channel_num, float32_t raw_value)
 {
 	uint8_t adc_index     = adc_num - 1;
 	uint8_t channel_index = channel_num - 1;
 
-	conversion_types[adc_index][channel_index] = conversion_linear;
-	if (conversion_parameters[adc_index][channel_index] != nullptr)
+	switch(conversion_types[adc_index][channel_index])
+	{
+		case conversion_linear:
+			return (raw_value*_data_conversion_get_raw_gain(adc_index, channel_index)) + conversion_parameters[adc_index][channel_index][1];
+			break;
+		case conversion_poly3:
+			return _data_conversion_evaluate_poly3(adc_index, channel_index, raw_value*raw_value_scales[adc_index]);
+			break;
+		case conversion_lut:
+		{
+			// Interpolate between table entries
+			float32_t position = raw_value*raw_value_scales[adc_index];
+			if (position <= 0)
+				return lut_tables[adc_index][channel_index][0];
+			if (position >= CONVERSION_LUT_SIZE-1)
+				return lut_tables[adc_index][channel_index][CONVERSION_LUT_SIZE-1];
+
+			uint32_t  index    = (uint32_t)position;
+			float32_t fraction = position - index;
+			float32_t low      = lut_tables[adc_index][channel_index][index];
+			float32_t high     = lut_tables[adc_index][channel_index][index+1];
+			return low + (high - low)*fraction;
+		}
+	}
+
+	return 0;
+}
+
+void data_conversion_convert_raw_buffer(uint8_t adc_num, uint8_t channel_num, const uint16_t* raw_values, size_t values_count, float32_t* converted_values)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	switch(conversion_types[adc_index][channel_index])
+	{
+		case conversion_linear:
+		{
+			if (raw_value_extra_bits[adc_index] >= 4)
+			{
+				// 16-bit raw values can't be seen as Q15 values
+				for (size_t i = 0 ; i < values_count ; i++)
+				{
+					converted_values[i] = data_conversion_convert_raw_value(adc_num, channel_num, raw_values[i]);
+				}
+				break;
+			}
+
+			// Raw values are seen as Q15 values, i.e. raw/32768,
+			// so gain is scaled accordingly.
+			float32_t gain   = _data_conversion_get_raw_gain(adc_index, channel_index) * 32768.f;
+			float32_t offset = conversion_parameters[adc_index][channel_index][1];
+
+			arm_q15_to_float((const q15_t*)raw_values, converted_values, values_count);
+			arm_scale_f32(converted_values, gain, converted_values, values_count);
+			arm_offset_f32(converted_values, offset, converted_values, values_count);
+			break;
+		}
+		case conversion_poly3:
+		{
+			float32_t scale = raw_value_scales[adc_index];
+			for (size_t i = 0 ; i < values_count ; i++)
+			{
+				converted_values[i] = _data_conversion_evaluate_poly3(adc_index, channel_index, raw_values[i]*scale);
+			}
+			break;
+		}
+		case conversion_lut:
+		{
+			const float32_t* table      = lut_tables[adc_index][channel_index];
+			uint8_t          extra_bits = raw_value_extra_bits[adc_index];
+			for (size_t i = 0 ; i < values_count ; i++)
+			{
+				converted_values[i] = table[(raw_values[i] >> extra_bits) & (CONVERSION_LUT_SIZE-1)];
+			}
+			break;
+		}
+	}
+}
+
+float32_t data_conversion_convert_raw_buffer_average(uint8_t adc_num, uint8_t channel_num, const uint16_t* raw_values, size_t values_count)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	if (values_count == 0)
+		return 0;
+
+	switch(conversion_types[adc_index][channel_index])
 	{
-		k_free(conversion_parameters[adc_index][channel_index]);
+		case conversion_linear:
+		{
+			// Conversion being linear, average of converted
+			// values is the conversion of the raw average.
+			uint32_t sum = 0;
+			for (size_t i = 0 ; i < values_count ; i++)
+			{
+				sum += raw_values[i];
+			}
+
+			float32_t raw_average = (float32_t)sum / values_count;
+			return (raw_average*_data_conversion_get_raw_gain(adc_index, channel_index)) + conversion_parameters[adc_index][channel_index][1];
+		}
+		default:
+		{
+			// Generic case: convert values by chunks, then average
+			float32_t converted_values[bulk_conversion_chunk_size];
+			float32_t sum = 0;
+
+			for (size_t i = 0 ; i < values_count ; i += bulk_conversion_chunk_size)
+			{
+				size_t chunk_size = values_count - i;
+				if (chunk_size > bulk_conversion_chunk_size)
+				{
+					chunk_size = bulk_conversion_chunk_size;
+				}
+
+				data_conversion_convert_raw_buffer(adc_num, channel_num, &raw_values[i], chunk_size, converted_values);
+
+				float32_t chunk_average;
+				arm_mean_f32(converted_values, chunk_size, &chunk_average);
+				sum += chunk_average * chunk_size;
+			}
+
+			return sum / values_count;
+		}
 	}
+}
+
+void data_conversion_set_conversion_parameters_linear(uint8_t adc_num, uint8_t channel_num, float32_t gain, float32_t offset)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
 
-	conversion_parameters[adc_index][channel_index] = (float32_t*)k_malloc(2*sizeof(float32_t));
+	_data_conversion_release_lut(adc_index, channel_index);
+
+	conversion_types[adc_index][channel_index] = conversion_linear;
+	conversion_parameters_set[adc_index][channel_index] = true;
 
 	conversion_parameters[adc_index][channel_index][0] = gain;
 	conversion_parameters[adc_index][channel_index][1] = offset;
+
+	_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+}
+
+void data_conversion_set_conversion_parameters_poly3(uint8_t adc_num, uint8_t channel_num, float32_t a0, float32_t a1, float32_t a2, float32_t a3)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	_data_conversion_release_lut(adc_index, channel_index);
+
+	conversion_types[adc_index][channel_index] = conversion_poly3;
+	conversion_parameters_set[adc_index][channel_index] = true;
+
+	conversion_parameters[adc_index][channel_index][0] = a0;
+	conversion_parameters[adc_index][channel_index][1] = a1;
+	conversion_parameters[adc_index][channel_index][2] = a2;
+	conversion_parameters[adc_index][channel_index][3] = a3;
+
+	_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+}
+
+int8_t data_conversion_set_conversion_parameters_lut(uint8_t adc_num, uint8_t channel_num, const float32_t* anchors, uint8_t anchors_count)
+{
+#if CONVERSION_LUT_COUNT > 0
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	if ( (anchors == nullptr) || (anchors_count < 2) || (anchors_count > CONVERSION_LUT_MAX_ANCHORS) )
+		return -1;
+
+	// Reuse the table of the channel, or get a free one
+	uint8_t lut_index = lut_indexes[adc_index][channel_index];
+	if (lut_tables[adc_index][channel_index] == nullptr)
+	{
+		lut_index = NO_LUT;
+		for (uint8_t i = 0 ; i < CONVERSION_LUT_COUNT ; i++)
+		{
+			if (lut_allocated[i] == false)
+			{
+				lut_index = i;
+				break;
+			}
+		}
+
+		if (lut_index == NO_LUT)
+			return -1;
+	}
+
+	lut_allocated[lut_index]     = true;
+	lut_anchors_count[lut_index] = anchors_count;
+	for (uint8_t i = 0 ; i < anchors_count ; i++)
+	{
+		lut_anchors[lut_index][i] = anchors[i];
+	}
+
+	// Build table by linear interpolation between anchors
+	float32_t* table = conversion_luts[lut_index];
+	float32_t  segment_length = (float32_t)(CONVERSION_LUT_SIZE-1) / (anchors_count-1);
+	for (uint32_t raw_value = 0 ; raw_value < CONVERSION_LUT_SIZE ; raw_value++)
+	{
+		float32_t position = raw_value / segment_length;
+		uint32_t  segment  = (uint32_t)position;
+		if (segment >= (uint32_t)(anchors_count-1))
+		{
+			segment = anchors_count-2;
+		}
+		float32_t fraction = position - segment;
+		table[raw_value] = anchors[segment] + (anchors[segment+1] - anchors[segment])*fraction;
+	}
+
+	conversion_types[adc_index][channel_index] = conversion_lut;
+	conversion_parameters_set[adc_index][channel_index] = true;
+	lut_indexes[adc_index][channel_index] = lut_index;
+	lut_tables[adc_index][channel_index]  = table;
+
+	_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+void data_conversion_set_raw_value_resolution(uint8_t adc_num, uint8_t extra_bits)
+{
+	uint8_t adc_index = adc_num - 1;
+
+	raw_value_extra_bits[adc_index] = extra_bits;
+	raw_value_scales[adc_index]     = 1.f / (float32_t)(1U << extra_bits);
+
+	for (int channel_index = 0 ; channel_index < CHANNELS_PER_ADC ; channel_index++)
+	{
+		_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+	}
+}
+
+void data_conversion_set_fixed_point_full_scale(uint8_t adc_num, uint8_t channel_num, float32_t full_scale)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	if (full_scale <= 0)
+		return;
+
+	fixed_point_full_scale[adc_index][channel_index]     = full_scale;
+	fixed_point_full_scale_set[adc_index][channel_index] = true;
+
+	_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+}
+
+float32_t data_conversion_get_fixed_point_full_scale(uint8_t adc_num, uint8_t channel_num)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	return fixed_point_full_scale[adc_index][channel_index];
+}
+
+q31_t data_conversion_convert_raw_value_q31(uint8_t adc_num, uint8_t channel_num, uint16_t raw_value)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	switch(conversion_types[adc_index][channel_index])
+	{
+		case conversion_linear:
+		{
+			int64_t value = (int64_t)raw_value*fixed_point_gain[adc_index][channel_index] + fixed_point_offset[adc_index][channel_index];
+			return clip_q63_to_q31(value);
+		}
+		default:
+		{
+			float32_t value = data_conversion_convert_raw_value(adc_num, channel_num, raw_value);
+			return _data_conversion_float_to_q31(value/fixed_point_full_scale[adc_index][channel_index]);
+		}
+	}
+}
+
+q15_t data_conversion_convert_raw_value_q15(uint8_t adc_num, uint8_t channel_num, uint16_t raw_value)
+{
+	return (q15_t)(data_conversion_convert_raw_value_q31(adc_num, channel_num, raw_value) >> 16);
 }
 
 conversion_type_t data_conversion_get_conversion_type(uint8_t adc_num, uint8_t channel_num)
@@ -137,8 +590,20 @@ float32_t data_conversion_get_parameter(uint8_t adc_num, uint8_t channel_num, ui
 	uint8_t channel_index   = channel_num - 1;
 	uint8_t parameter_index = parameter_num - 1;
 
-	if (conversion_parameters[adc_index][channel_index] != nullptr)
+	if (conversion_parameters_set[adc_index][channel_index] == true)
 	{
+#if CONVERSION_LUT_COUNT > 0
+		if (conversion_types[adc_index][channel_index] == conversion_lut)
+		{
+			uint8_t lut_index = lut_indexes[adc_index][channel_index];
+			if (parameter_index < lut_anchors_count[lut_index])
+			{
+				return lut_anchors[lut_index][parameter_index];
+			}
+			return 0;
+		}
+#endif
+
 		uint8_t param_count = _data_conversion_get_parameters_count(conversion_types[adc_index][channel_index]);
 		if (parameter_index < param_count)
 		{
@@ -152,57 +617,38 @@ float32_t data_conversion_get_parameter(uint8_t adc_num, uint8_t channel_num, ui
 
 int8_t data_conversion_store_channel_parameters_in_nvs(uint8_t adc_num, uint8_t channel_num)
 {
-	/* Handle non volatile memory used to store ADC parameters
-	 * Flash partition reserved to user data storage is 4kB long
-	 * We have to mount the file system then we extract one
-	 * memory page that is 4kB long that contains the data
-	 * and write the relevant addresses to store ADC parameters.
-	 */
-
 	uint8_t adc_index     = adc_num - 1;
 	uint8_t channel_index = channel_num - 1;
 
-	// The data structure is as follows:
-	// - 1 byte indicating the channel descriptor string size
-	// - The channel descriptor string (should be max. 23 bytes in current version)
+	// Parameters are stored in the calibration record,
+	// with an entry structured as follows:
 	// - 1 byte indicating ADC number
 	// - 1 byte indicating channel number
-	// - 1 byte indicating number of conversion parameters
+	// - 1 byte indicating conversion type
 	// - Array of conversion parameters, each using 4 bytes.
-
+	//   For lookup-table conversion, parameters are the table anchors.
 
 	uint8_t parameters_count = _data_conversion_get_parameters_count(conversion_types[adc_index][channel_index]);
-
-	uint8_t* buffer = (uint8_t*)k_malloc(1 + 23 + 1 + 1 + 1 + 4*parameters_count);
-
-	snprintk((char*)(&buffer[1]), 23, "Spin_ADC_%u_Channel_%u", adc_num, channel_num);
-
-	uint8_t string_len = strlen((char*)(&buffer[1]));
-
-	buffer[0] = string_len;
-	// Buffer [1 -> string_len] contains channel name (\0 will be overwritten)
-	buffer[string_len + 1] = adc_num;
-	buffer[string_len + 2] = channel_num;
-	buffer[string_len + 3] = conversion_types[adc_index][channel_index];
-	for (int i = 0 ; i < parameters_count ; i++)
+	const float32_t* parameters = conversion_parameters[adc_index][channel_index];
+#if CONVERSION_LUT_COUNT > 0
+	if (conversion_types[adc_index][channel_index] == conversion_lut)
 	{
-		*((float32_t*)&buffer[string_len + 4 + 4*i]) = conversion_parameters[adc_index][channel_index][i];
+		uint8_t lut_index = lut_indexes[adc_index][channel_index];
+		parameters_count  = lut_anchors_count[lut_index];
+		parameters        = lut_anchors[lut_index];
 	}
+#endif
 
-	uint16_t channel_ID = ADC_CALIBRATION | (adc_num&0x0F) << 4 | (channel_num&0x0F);
+	uint8_t buffer[3 + 4*CONVERSION_LUT_MAX_ANCHORS];
 
-	int ns = nvs_storage_store_data(channel_ID, buffer, 1 + string_len + 1 + 1 + 1 + 4*parameters_count);
+	buffer[0] = adc_num;
+	buffer[1] = channel_num;
+	buffer[2] = conversion_types[adc_index][channel_index];
+	memcpy(&buffer[3], parameters, 4*parameters_count);
 
-	k_free(buffer);
+	uint16_t channel_ID = ADC_CALIBRATION | (adc_num&0x0F) << 4 | (channel_num&0x0F);
 
-	if (ns < 0)
-	{
-		return -1;
-	}
-	else
-	{
-		return 0;
-	}
+	return nvs_storage_calibration_set(channel_ID, buffer, 3 + 4*parameters_count);
 }
 
 int8_t data_conversion_retrieve_channel_parameters_from_nvs(uint8_t adc_num, uint8_t channel_num)
@@ -223,48 +669,104 @@ int8_t data_conversion_retrieve_channel_parameters_from_nvs(uint8_t adc_num, uin
 
 	uint16_t channel_ID = ADC_CALIBRATION | (adc_num&0x0F) << 4 | (channel_num&0x0F);
 
-	int buffer_size = 1 + 23 + 1 + 1 + 1 + 4*max_parameters_count;
-	uint8_t* buffer = (uint8_t*)k_malloc(buffer_size);
-
-	int read_size = nvs_storage_retrieve_data(channel_ID, buffer, buffer_size);
+	// Buffer is large enough for legacy records, which are prefixed with:
+	// - 1 byte indicating the channel descriptor string size
+	// - The channel descriptor string (max. 23 bytes)
+	uint8_t buffer[1 + 23 + 3 + 4*CONVERSION_LUT_MAX_ANCHORS];
+	const uint8_t* entry = buffer;
+	bool legacy = false;
 
-	int ret = 0;
-	if (read_size > 0)
+	int entry_size = nvs_storage_calibration_get(channel_ID, buffer, sizeof(buffer));
+	if (entry_size <= 0)
 	{
+		// Parameters may have been stored individually by a previous version
+		int read_size = nvs_storage_retrieve_data(channel_ID, buffer, sizeof(buffer));
+		if (read_size <= 0)
+		{
+			return -4;
+		}
+
 		uint8_t string_len = buffer[0];
+		entry      = &buffer[string_len + 1];
+		entry_size = read_size - (string_len + 1);
+		legacy     = true;
+	}
+
+	// Check that all required values match
+	if ( (entry_size < 3) || (adc_num != entry[0]) || (channel_num != entry[1]) )
+	{
+		return -3;
+	}
+
+	conversion_type_t conversion_type = (conversion_type_t)entry[2];
+	int parameters_count = (entry_size - 3) / 4;
+	if (parameters_count > CONVERSION_LUT_MAX_ANCHORS)
+	{
+		return -3;
+	}
 
-		// Check that all required values match
-		if (adc_num != buffer[string_len + 1])
+	float32_t parameters[CONVERSION_LUT_MAX_ANCHORS];
+	memcpy(parameters, &entry[3], 4*parameters_count);
+
+	if (conversion_type == conversion_lut)
+	{
+		if (data_conversion_set_conversion_parameters_lut(adc_num, channel_num, parameters, parameters_count) != 0)
 		{
-			ret = -3;
+			return -3;
 		}
-		else if (channel_num != buffer[string_len + 2])
+	}
+	else
+	{
+		if (parameters_count < _data_conversion_get_parameters_count(conversion_type))
 		{
-			ret = -3;
+			return -3;
 		}
-		else
-		{
-			conversion_type_t conversion_type = (conversion_type_t)buffer[string_len + 3];
-			uint8_t parameters_count = _data_conversion_get_parameters_count(conversion_type);
-			conversion_types[adc_index][channel_index] = conversion_type;
 
-			if (conversion_parameters[adc_index][channel_index] != nullptr)
-			{
-				k_free(conversion_parameters[adc_index][channel_index]);
-			}
-			conversion_parameters[adc_index][channel_index] = (float32_t*)k_malloc(parameters_count*sizeof(float32_t));
+		_data_conversion_release_lut(adc_index, channel_index);
+		conversion_types[adc_index][channel_index] = conversion_type;
+		conversion_parameters_set[adc_index][channel_index] = true;
 
-			for (int i = 0 ; i < parameters_count ; i++)
-			{
-				conversion_parameters[adc_index][channel_index][i] = *((float32_t*)&buffer[string_len + 4 + 4*i]);
-			}
+		for (int i = 0 ; i < _data_conversion_get_parameters_count(conversion_type) ; i++)
+		{
+			conversion_parameters[adc_index][channel_index][i] = parameters[i];
 		}
+
+		_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
 	}
-	else
+
+	if (legacy == true)
 	{
-		ret = -4;
+		// Move entry to calibration record: individual record
+		// is deleted once calibration record is written.
+		nvs_storage_calibration_migrate(channel_ID, entry, entry_size);
 	}
 
-	k_free(buffer);
-	return ret;
+	return 0;
 }
+
+
+#ifdef CONFIG_OWNTECH_DATA_API_BENCHMARK
+
+/////
+// Benchmark hooks
+
+void data_conversion_benchmark_reset(uint8_t adc_num, uint8_t channel_num)
+{
+	uint8_t adc_index     = adc_num - 1;
+	uint8_t channel_index = channel_num - 1;
+
+	_data_conversion_release_lut(adc_index, channel_index);
+
+	// Back to the state of a channel that was never configured,
+	// so that initialization sets default parameters.
+	conversion_types[adc_index][channel_index]          = conversion_linear;
+	conversion_parameters_set[adc_index][channel_index] = false;
+	for (uint8_t parameter = 0 ; parameter < max_parameters_count ; parameter++)
+	{
+		conversion_parameters[adc_index][channel_index][parameter] = 0;
+	}
+
+	_data_conversion_update_fixed_point_parameters(adc_index, channel_index);
+}
+
+#endif // CONFIG_OWNTECH_DATA_API_BENCHMARK
@@ -36,10 +36,16 @@
 
 typedef enum : uint8_t
 {
-	conversion_linear = 0
-
+	conversion_linear = 0,
+	conversion_poly3  = 1,
+	conversion_lut    = 2
 } conversion_type_t;
 
+// Lookup-table conversion: table has one entry per 12-bit raw value,
+// built by linear interpolation between evenly spaced anchor values.
+static const uint16_t CONVERSION_LUT_SIZE        = 4096;
+static const uint8_t  CONVERSION_LUT_MAX_ANCHORS = 33;
+
 /////
 // API
 
@@ -59,6 +65,107 @@ void data_conversion_init();
  */
 float32_t data_conversion_convert_raw_value(uint8_t adc_num, uint8_t channel_num, uint16_t raw_value);
 
+/**
+ * @brief    Converts a fractional raw value, such as a filter output,
+ *           into a physical unit.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ * @param[in] raw_value   Value to convert, in raw value units
+ *
+ * @return   A float32_t value representing the value in the physical unit of the given channel.
+ */
+float32_t data_conversion_convert_fractional_raw_value(uint8_t adc_num, uint8_t channel_num, float32_t raw_value);
+
+/**
+ * @brief    Converts a buffer of raw values into a physical unit.
+ *           Conversion is done in one pass using CMSIS-DSP vector functions.
+ *
+ * @param[in]  adc_num          ADC number
+ * @param[in]  channel_num      Channel number
+ * @param[in]  raw_values       Buffer of values to convert
+ * @param[in]  values_count     Number of values in the buffer
+ * @param[out] converted_values Buffer to store the converted values,
+ *                              able to hold at least values_count values
+ */
+void data_conversion_convert_raw_buffer(uint8_t adc_num, uint8_t channel_num, const uint16_t* raw_values, size_t values_count, float32_t* converted_values);
+
+/**
+ * @brief    Converts a buffer of raw values into a physical unit
+ *           and returns the average of the converted values.
+ *           For linear conversion, raw values are averaged using
+ *           integer arithmetic and only the average is converted.
+ *
+ * @param[in] adc_num      ADC number
+ * @param[in] channel_num  Channel number
+ * @param[in] raw_values   Buffer of values to convert
+ * @param[in] values_count Number of values in the buffer
+ *
+ * @return   Average value of the buffer in the physical unit of the given channel,
+ *           or 0 if the buffer is empty.
+ */
+float32_t data_conversion_convert_raw_buffer_average(uint8_t adc_num, uint8_t channel_num, const uint16_t* raw_values, size_t values_count);
+
+/**
+ * @brief    Converts a raw value into a physical unit expressed in Q31 format,
+ *           as a fraction of the channel full scale. For linear conversion,
+ *           this function only uses integer arithmetic.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ * @param[in] raw_value   Value to convert
+ *
+ * @return   Converted value divided by channel full scale, in Q31 format,
+ *           saturated to [-1, 1[.
+ */
+q31_t data_conversion_convert_raw_value_q31(uint8_t adc_num, uint8_t channel_num, uint16_t raw_value);
+
+/**
+ * @brief    Converts a raw value into a physical unit expressed in Q15 format,
+ *           as a fraction of the channel full scale. For linear conversion,
+ *           this function only uses integer arithmetic.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ * @param[in] raw_value   Value to convert
+ *
+ * @return   Converted value divided by channel full scale, in Q15 format,
+ *           saturated to [-1, 1[.
+ */
+q15_t data_conversion_convert_raw_value_q15(uint8_t adc_num, uint8_t channel_num, uint16_t raw_value);
+
+/**
+ * @brief    Set the resolution of raw values provided by an ADC.
+ *           Conversion parameters always apply to 12-bit raw values:
+ *           when ADC is oversampled, gains are scaled accordingly.
+ *
+ * @param[in] adc_num    ADC number
+ * @param[in] extra_bits Number of bits of raw values above 12, from 0 to 4.
+ */
+void data_conversion_set_raw_value_resolution(uint8_t adc_num, uint8_t extra_bits);
+
+/**
+ * @brief    Set the full scale used by fixed-point conversion of a given channel.
+ *           If not set, full scale defaults to the largest absolute value the
+ *           channel can output with its current conversion parameters.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ * @param[in] full_scale  Value in physical unit that maps to 1 in fixed-point format.
+ *                        Must be strictly positive.
+ */
+void data_conversion_set_fixed_point_full_scale(uint8_t adc_num, uint8_t channel_num, float32_t full_scale);
+
+/**
+ * @brief    Get the full scale used by fixed-point conversion of a given channel.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ *
+ * @return   Value in physical unit that maps to 1 in fixed-point format.
+ */
+float32_t data_conversion_get_fixed_point_full_scale(uint8_t adc_num, uint8_t channel_num);
+
 /**
  * @brief    Change the parameters for the data conversion of a given channel.
  *
@@ -69,6 +176,38 @@ float32_t data_conversion_convert_raw_value(uint8_t adc_num, uint8_t channel_num
  */
 void data_conversion_set_conversion_parameters_linear(uint8_t adc_num, uint8_t channel_num, float32_t gain, float32_t offset);
 
+/**
+ * @brief    Set a third-order polynomial conversion for a given channel:
+ *           value = a0 + a1*raw + a2*raw^2 + a3*raw^3, with raw the 12-bit
+ *           raw value.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ * @param[in] a0          Constant coefficient
+ * @param[in] a1          First order coefficient
+ * @param[in] a2          Second order coefficient
+ * @param[in] a3          Third order coefficient
+ */
+void data_conversion_set_conversion_parameters_poly3(uint8_t adc_num, uint8_t channel_num, float32_t a0, float32_t a1, float32_t a2, float32_t a3);
+
+/**
+ * @brief    Set a lookup-table conversion for a given channel. The table
+ *           holds the converted value of each 12-bit raw value, so that
+ *           conversion is a single memory read. It is computed by linear
+ *           interpolation between anchors, which are the converted values
+ *           of evenly spaced raw values: anchor i is the value at raw value
+ *           i*4095/(anchors_count-1). Only anchors are stored in NVS.
+ *
+ * @param[in] adc_num       ADC number
+ * @param[in] channel_num   Channel number
+ * @param[in] anchors       Converted values at anchor points
+ * @param[in] anchors_count Number of anchors, from 2 to CONVERSION_LUT_MAX_ANCHORS
+ *
+ * @return 0 if conversion was set, -1 if anchors count is invalid
+ *         or all tables are used by other channels.
+ */
+int8_t data_conversion_set_conversion_parameters_lut(uint8_t adc_num, uint8_t channel_num, const float32_t* anchors, uint8_t anchors_count);
+
 /**
  * @brief Get the conversion type for a given channel
  *
@@ -85,7 +224,9 @@ conversion_type_t data_conversion_get_conversion_type(uint8_t adc_num, uint8_t c
  * @param[in] adc_num       ADC number
  * @param[in] channel_num   Channel number
  * @param[in] parameter_num Number of the paramter to retreive. E.g. for linear parameters,
- *                          gain is param 1 and offset is param 2.
+ *                          gain is param 1 and offset is param 2. For polynomial
+ *                          parameters, a0 to a3 are params 1 to 4. For lookup
+ *                          table parameters, anchors are params 1 to anchors count.
  *
  * @return Current value of the given parameter.
  */
@@ -115,5 +256,18 @@ int8_t data_conversion_store_channel_parameters_in_nvs(uint8_t adc_num, uint8_t
  */
 int8_t data_conversion_retrieve_channel_parameters_from_nvs(uint8_t adc_num, uint8_t channel_num);
 
+#ifdef CONFIG_OWNTECH_DATA_API_BENCHMARK
+
+/**
+ * @brief Benchmark hook: reset the conversion of a given channel
+ *        to the state of a channel that was never configured.
+ *
+ * @param[in] adc_num     ADC number
+ * @param[in] channel_num Channel number
+ */
+void data_conversion_benchmark_reset(uint8_t adc_num, uint8_t channel_num);
+
+#endif
+
 
 #endif // DATA_CONVERSION_H_
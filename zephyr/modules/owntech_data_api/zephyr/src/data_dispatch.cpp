@@ -30,13 +30,16 @@
 
 //Zephyr
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 
 // OwnTech API
 #include "SpinAPI.h"
+#include "hrtim.h"
 
 // Current module header
 #include "DataAPI.h"
 #include "dma.h"
+#include "data_capture.h"
 
 // Current file header
 #include "data_dispatch.h"
@@ -45,100 +48,506 @@
 /////
 // Local variables
 
-#define CHANNELS_BUFFERS_SIZE 32
+#define CHANNELS_BUFFERS_SIZE CONFIG_OWNTECH_DATA_API_CHANNEL_BUFFER_SIZE
+#define CHANNELS_BUFFERS_MASK (CHANNELS_BUFFERS_SIZE - 1)
+#define MAX_CHANNELS_PER_ADC  CONFIG_OWNTECH_DATA_API_MAX_CHANNELS_PER_ADC
+#define MAX_CURSORS_PER_CHANNEL CONFIG_OWNTECH_DATA_API_MAX_CURSORS_PER_CHANNEL
+#define DMA_BUFFERS_POOL_SIZE CONFIG_OWNTECH_DATA_API_DMA_BUFFERS_SIZE
+
+BUILD_ASSERT((CHANNELS_BUFFERS_SIZE & CHANNELS_BUFFERS_MASK) == 0,
+             "Channel buffer size must be a power of two");
+BUILD_ASSERT(MAX_CURSORS_PER_CHANNEL <= ATOMIC_BITS,
+             "Cursors of a channel must fit in a single atomic bitmap");
 
 // Number of channels in each ADC (cell i is ADC number i+1)
-static uint8_t* enabled_channels_count = nullptr;
-
-// Array of per-adc/per-channel buffers.
-// adc_channel_buffers[x][y][z][] is ADC x+1 channel y buffer z
-// with z either 0 or 1 as there are two buffers per channel (double buffering)
-static uint16_t**** adc_channel_buffers = nullptr;
-
-// Number of readings stored in each channel.
-// buffers_data_count[x][y] is the current nuumber of
-// values stored in the currently written buffer of ADC x+1 Channel y
-static uint32_t** buffers_data_count = nullptr;
-
-// Currently written buffer for each channel.
-// Either 0 or 1.
-// If current_buffer[x][y] is 0, the currently written buffer
-// for ADC x+1 Channel y is buffer 0 and the user buffer is buffer 1
-static uint8_t** current_buffer = nullptr;
-
-// Small memory to retain latest value available to
-// the peek() function after a buffer swap.
-static uint16_t** peek_memory = nullptr;
-
-// DMA buffers: data from the ADC 1/2 are stored in these
-// buffers until dispatch is done (ADC 3/4 won't use DMA).
+static uint8_t enabled_channels_count[ADC_COUNT] = {0};
+
+// Per-adc/per-channel ring buffers, stored in a single contiguous block.
+// channel_rings[x][y][] is the ring of ADC x+1 channel rank y+1.
+// Each ring is mirrored: a value is written both at index i and
+// i+CHANNELS_BUFFERS_SIZE, so that any window of at most
+// CHANNELS_BUFFERS_SIZE values starting in the first half
+// is contiguous in memory and can be handed to the user as is.
+static uint16_t channel_rings[ADC_COUNT][MAX_CHANNELS_PER_ADC][2*CHANNELS_BUFFERS_SIZE];
+
+// Ring indexes. These are free-running counters that are only
+// masked when accessing the ring, so that head - tail is the
+// number of values acquired since a reader last read the ring.
+// Head is only written by the producer (dispatch), which never
+// waits for readers. Each channel can have multiple readers
+// (cursors), each having its own tail which is only accessed
+// by the reader. A reader that falls more than the ring size
+// behind loses its oldest values, without affecting others.
+// Cursor 0 is the default cursor, used by data.get*() functions.
+static volatile uint32_t ring_heads[ADC_COUNT][MAX_CHANNELS_PER_ADC] = {0};
+static uint32_t cursor_tails[ADC_COUNT][MAX_CHANNELS_PER_ADC][MAX_CURSORS_PER_CHANNEL] = {0};
+
+// Cursors state. Bit i of cursor_registered is set when cursor i
+// is registered. A cursor only becomes active on its first read.
+static atomic_t cursor_registered[ADC_COUNT][MAX_CHANNELS_PER_ADC] = {0};
+static bool     cursor_active[ADC_COUNT][MAX_CHANNELS_PER_ADC][MAX_CURSORS_PER_CHANNEL] = {0};
+
+// Number of values each cursor lost because it fell behind.
+static uint32_t cursor_overruns[ADC_COUNT][MAX_CHANNELS_PER_ADC][MAX_CURSORS_PER_CHANNEL] = {0};
+
+// Latest dispatched value of each channel, available to
+// the peek() function even when the ring is full.
+static volatile uint16_t latest_values[ADC_COUNT][MAX_CHANNELS_PER_ADC] = {0};
+
+// Sequence number of the latest dispatched value of each
+// channel, i.e. number of values acquired since start, and
+// HRTIM master period at which it was dispatched.
+static volatile uint32_t sequence_numbers[ADC_COUNT][MAX_CHANNELS_PER_ADC] = {0};
+static volatile uint32_t latest_periods[ADC_COUNT][MAX_CHANNELS_PER_ADC]   = {0};
+
+// Per-channel filters, fed with all dispatched
+// values, including those lost on overrun.
+static filter_state_t channel_filters[ADC_COUNT][MAX_CHANNELS_PER_ADC];
+
+// Per-channel running statistics, fed the same way as filters.
+static stats_state_t channel_stats[ADC_COUNT][MAX_CHANNELS_PER_ADC];
+
+// Time base: HRTIM master time is extrapolated from CPU cycles
+// elapsed since the previous time base, and realigned on the
+// HRTIM master counter. System uptime is recorded along with the
+// cycle counter to account for its wraps (about every 25 s).
+static uint32_t           time_base_cycles       = 0;
+static int64_t            time_base_uptime_ticks = 0;
+static sample_timestamp_t time_base              = {0, 0};
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+
+// Timestamp lane of each ring, mirrored the same way as values.
+static sample_timestamp_t channel_timestamps[ADC_COUNT][MAX_CHANNELS_PER_ADC][2*CHANNELS_BUFFERS_SIZE];
+
+// Time span of the block being dispatched for each ADC
+static sample_timestamp_t previous_dispatch_times[ADC_COUNT];
+static sample_timestamp_t block_starts[ADC_COUNT];
+static uint32_t           block_durations[ADC_COUNT] = {0};
+
+#endif
+
+// DMA buffers: data from each ADC are stored in these
+// buffers until dispatch is done.
 // Main buffers are always used, while secondary buffers
 // will only be used when double-buffering is activated.
 // Double buffering is activated in Interrupt mode,
 // while Task mode doesn't need it.
+// Buffers are carved at init from a statically allocated
+// pool shared by all ADCs. Pool is word-aligned as dual
+// mode transfers pairs of values as 32-bit words.
+static uint16_t dma_buffers_pool[DMA_BUFFERS_POOL_SIZE] __aligned(4);
 static uint16_t* dma_main_buffers[ADC_COUNT]      = {0};
 static uint16_t* dma_secondary_buffers[ADC_COUNT] = {0};
 static uint8_t   current_dma_buffer[ADC_COUNT]    = {0};
 static size_t    dma_buffer_sizes[ADC_COUNT]      = {0};
 
+// Index in DMA buffer of the next value to dispatch (Task mode only)
+static size_t next_dma_buffer_index[ADC_COUNT] = {0};
+
+// Latest dispatched block of values in DMA buffers,
+// used to build channel views.
+static uint16_t* dispatched_buffer[ADC_COUNT]      = {0};
+static size_t    dispatched_buffer_size[ADC_COUNT] = {0};
+static size_t    dispatched_first_index[ADC_COUNT] = {0};
+static size_t    dispatched_count[ADC_COUNT]       = {0};
+
+// Dual mode: ADC 1 DMA buffer holds pairs of simultaneous
+// values, ADC 1 value followed by ADC 2 value, and ADC 2
+// has no DMA buffer of its own.
+static bool dual_mode = false;
+
+// Latest dispatched pair of each rank in dual mode,
+// ADC 1 value in low half-word, ADC 2 value in high half-word.
+static volatile uint32_t latest_pairs[MAX_CHANNELS_PER_ADC] = {0};
+
 // Dispatch method
 static dispatch_t dispatch_type;
 
+// Copy of values to per-channel buffers
+static bool copy_to_channel_buffers = true;
+
 
 /////
 // Private functions
 
-__STATIC_INLINE uint16_t* _data_dispatch_get_buffer(uint8_t adc_index, uint8_t channel_index)
+/**
+ * Get the number of ADCs sharing the DMA buffer of an ADC,
+ * and the position (lane) of this ADC values in each group
+ * of simultaneous values. Only lane 0 owns the DMA buffer.
+ */
+__STATIC_INLINE uint8_t _data_dispatch_get_lanes(uint8_t adc_index, uint8_t& lane)
+{
+	if ( (dual_mode == true) && (adc_index <= 1) )
+	{
+		lane = adc_index;
+		return 2;
+	}
+
+	lane = 0;
+	return 1;
+}
+
+/**
+ * Compute the offset between the first value of a dispatched
+ * block and the first value of a given slot in the sequence.
+ */
+__STATIC_INLINE size_t _data_dispatch_get_slot_offset(uint8_t slot, uint8_t first_slot, uint8_t sequence_size)
+{
+	if (slot >= first_slot)
+	{
+		return slot - first_slot;
+	}
+	else
+	{
+		return slot + sequence_size - first_slot;
+	}
+}
+
+/**
+ * Get the number of CPU cycles elapsed since the previous time base.
+ * The 32-bit cycle counter gives the exact count modulo 2^32, while
+ * the 64-bit system uptime, which is way more precise than a counter
+ * wrap, gives the number of wraps in between.
+ */
+__STATIC_INLINE uint64_t _data_dispatch_get_elapsed_cycles(uint32_t cycles, int64_t uptime_ticks)
+{
+	uint32_t elapsed_cycles   = cycles - time_base_cycles;
+	uint64_t estimated_cycles = k_ticks_to_cyc_floor64(uptime_ticks - time_base_uptime_ticks);
+
+	// Round to the nearest number of wraps
+	uint64_t wraps = 0;
+	if (estimated_cycles > elapsed_cycles)
+	{
+		wraps = (estimated_cycles - elapsed_cycles + (1ULL << 31)) >> 32;
+	}
+
+	return (wraps << 32) + elapsed_cycles;
+}
+
+/**
+ * Get current HRTIM master time. This only requires a single read
+ * of the HRTIM master counter and of the CPU cycle counter: number
+ * of elapsed periods is deduced from CPU cycles elapsed since the
+ * previous call, and rounded to match the master counter offset.
+ */
+static sample_timestamp_t _data_dispatch_get_time()
+{
+	uint32_t period_ticks = hrtim_period_Master_get();
+
+	unsigned int key = irq_lock();
+
+	uint32_t cycles       = k_cycle_get_32();
+	int64_t  uptime_ticks = k_uptime_ticks();
+
+	if (period_ticks != 0)
+	{
+		uint16_t offset = hrtim_cnt_Master_get();
+
+		// HRTIM clock is 32 times CPU clock, divided by master prescaler
+		uint64_t elapsed_cycles = _data_dispatch_get_elapsed_cycles(cycles, uptime_ticks);
+		uint64_t elapsed_ticks  = (elapsed_cycles << 5) >> hrtim_ckpsc_Master_get();
+		int64_t  ticks = (int64_t)elapsed_ticks + time_base.offset - offset + period_ticks/2;
+
+		uint32_t elapsed_periods = 0;
+		if (ticks > UINT32_MAX)
+		{
+			elapsed_periods = (uint32_t)(ticks / period_ticks);
+		}
+		else if (ticks > 0)
+		{
+			elapsed_periods = (uint32_t)ticks / period_ticks;
+		}
+
+		time_base.period += elapsed_periods;
+		time_base.offset  = offset;
+	}
+
+	time_base_cycles       = cycles;
+	time_base_uptime_ticks = uptime_ticks;
+	sample_timestamp_t now = time_base;
+
+	irq_unlock(key);
+
+	return now;
+}
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+
+/**
+ * Record the time span of the block being dispatched for an ADC,
+ * from the previous dispatch of this ADC to now.
+ */
+static void _data_dispatch_update_block_time(uint8_t adc_index, sample_timestamp_t block_end)
+{
+	sample_timestamp_t block_start = previous_dispatch_times[adc_index];
+	uint32_t period_ticks = hrtim_period_Master_get();
+
+	int64_t duration = 0;
+	if (period_ticks != 0)
+	{
+		duration = (int64_t)(block_end.period - block_start.period) * period_ticks + block_end.offset - block_start.offset;
+	}
+
+	if (duration < 0)
+	{
+		duration = 0;
+	}
+	else if (duration > UINT32_MAX)
+	{
+		duration = UINT32_MAX;
+	}
+
+	block_starts[adc_index]            = block_start;
+	block_durations[adc_index]         = (uint32_t)duration;
+	previous_dispatch_times[adc_index] = block_end;
+}
+
+#endif
+
+/**
+ * Copy values of a single channel from the DMA buffer to its
+ * ring buffer. Values of a channel are interleaved in the DMA
+ * buffer with a stride equal to the number of values acquired
+ * on each sequence trigger.
+ * Values are always written: oldest values of the ring are
+ * overwritten, and cursors that did not read them yet account
+ * for the loss on their next read.
+ *
+ * @param adc_index Index of the ADC (ADC number - 1).
+ * @param channel_index Index of the channel (channel rank - 1).
+ * @param dma_buffer DMA buffer to read values from.
+ * @param dma_buffer_size Size of DMA buffer, at which read wraps.
+ * @param dma_index Index of first value of channel in DMA buffer.
+ * @param stride Distance between two values of the channel in DMA buffer.
+ * @param values_count Number of values to copy.
+ */
+__STATIC_INLINE void _data_dispatch_copy_channel(uint8_t   adc_index,
+                                                 uint8_t   channel_index,
+                                                 uint16_t* dma_buffer,
+                                                 size_t    dma_buffer_size,
+                                                 size_t    dma_index,
+                                                 uint8_t   stride,
+                                                 size_t    values_count)
+{
+	uint16_t* ring = channel_rings[adc_index][channel_index];
+	uint32_t  head = ring_heads[adc_index][channel_index];
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+	// Spread values evenly over the block time span
+	sample_timestamp_t* timestamps   = channel_timestamps[adc_index][channel_index];
+	sample_timestamp_t  timestamp    = block_starts[adc_index];
+	uint32_t            period_ticks = hrtim_period_Master_get();
+	uint32_t            step_periods = 0;
+	uint32_t            step_offset  = 0;
+	if ( (period_ticks != 0) && (values_count != 0) )
+	{
+		uint32_t step = block_durations[adc_index] / values_count;
+		step_periods  = step / period_ticks;
+		step_offset   = step % period_ticks;
+	}
+#endif
+
+	uint16_t value = 0;
+	for (size_t i = 0 ; i < values_count ; i++)
+	{
+		value = dma_buffer[dma_index];
+
+		uint32_t ring_index = head & CHANNELS_BUFFERS_MASK;
+		ring[ring_index]                         = value;
+		ring[ring_index + CHANNELS_BUFFERS_SIZE] = value;
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+		timestamp.period += step_periods;
+		uint32_t offset = timestamp.offset + step_offset;
+		if ( (period_ticks != 0) && (offset >= period_ticks) )
+		{
+			offset -= period_ticks;
+			timestamp.period++;
+		}
+		timestamp.offset = offset;
+
+		timestamps[ring_index]                         = timestamp;
+		timestamps[ring_index + CHANNELS_BUFFERS_SIZE] = timestamp;
+#endif
+
+		head++;
+
+		dma_index += stride;
+		if (dma_index >= dma_buffer_size)
+		{
+			dma_index -= dma_buffer_size;
+		}
+	}
+
+	latest_values[adc_index][channel_index] = value;
+
+	// Make sure values are written before publishing them
+	__DMB();
+	ring_heads[adc_index][channel_index] = head;
+}
+
+/**
+ * Feed values of a single channel from the DMA buffer to
+ * its filter. Parameters are the same as for
+ * _data_dispatch_copy_channel().
+ */
+__STATIC_INLINE void _data_dispatch_filter_channel(uint8_t   adc_index,
+                                                   uint8_t   channel_index,
+                                                   uint16_t* dma_buffer,
+                                                   size_t    dma_buffer_size,
+                                                   size_t    dma_index,
+                                                   uint8_t   stride,
+                                                   size_t    values_count)
 {
-	uint8_t active_buffer = current_buffer[adc_index][channel_index];
-	return adc_channel_buffers[adc_index][channel_index][active_buffer];
+	filter_state_t* filter = &channel_filters[adc_index][channel_index];
+
+	for (size_t i = 0 ; i < values_count ; i++)
+	{
+		data_filter_push(filter, dma_buffer[dma_index]);
+
+		dma_index += stride;
+		if (dma_index >= dma_buffer_size)
+		{
+			dma_index -= dma_buffer_size;
+		}
+	}
 }
 
-__STATIC_INLINE uint32_t _data_dispatch_get_count(uint8_t adc_index, uint8_t channel_index)
+/**
+ * Feed values of a single channel from the DMA buffer to
+ * its statistics. Parameters are the same as for
+ * _data_dispatch_copy_channel().
+ */
+__STATIC_INLINE void _data_dispatch_stats_channel(uint8_t   adc_index,
+                                                  uint8_t   channel_index,
+                                                  uint16_t* dma_buffer,
+                                                  size_t    dma_buffer_size,
+                                                  size_t    dma_index,
+                                                  uint8_t   stride,
+                                                  size_t    values_count)
 {
-	return buffers_data_count[adc_index][channel_index];
+	stats_state_t* stats = &channel_stats[adc_index][channel_index];
+
+	for (size_t i = 0 ; i < values_count ; i++)
+	{
+		data_stats_push(stats, dma_buffer[dma_index]);
+
+		dma_index += stride;
+		if (dma_index >= dma_buffer_size)
+		{
+			dma_index -= dma_buffer_size;
+		}
+	}
 }
 
-__STATIC_INLINE void _data_dispatch_increment_count(uint8_t adc_index, uint8_t channel_index)
+/**
+ * Record the latest pair of simultaneous values of each rank
+ * in dual mode. Values of a pair are adjacent in DMA buffer,
+ * ADC 1 value being at an even index.
+ */
+__STATIC_INLINE void _data_dispatch_update_pairs(uint16_t* dma_buffer,
+                                                 size_t    dma_buffer_size,
+                                                 size_t    first_dma_index,
+                                                 size_t    data_count,
+                                                 uint8_t   sequence_size)
 {
-	uint32_t* current_count = &buffers_data_count[adc_index][channel_index];
-	if ( (*current_count) < CHANNELS_BUFFERS_SIZE)
+	uint8_t first_slot = first_dma_index % sequence_size;
+
+	for (uint8_t slot = 0 ; slot < sequence_size ; slot += 2)
 	{
-		(*current_count)++;
+		size_t offset = _data_dispatch_get_slot_offset(slot, first_slot, sequence_size);
+		if (offset >= data_count)
+			continue;
+
+		size_t last_index = first_dma_index + offset + ((data_count - offset - 1) / sequence_size) * sequence_size;
+		if (last_index >= dma_buffer_size)
+		{
+			last_index -= dma_buffer_size;
+		}
+
+		latest_pairs[slot/2] = (uint32_t)dma_buffer[last_index] | ((uint32_t)dma_buffer[last_index+1] << 16);
 	}
 }
 
-__STATIC_INLINE void _data_dispatch_swap_buffers(uint8_t adc_index, uint8_t channel_index)
+/**
+ * Build a view on the values of a slot of the sequence
+ * in a dispatched block of a DMA buffer.
+ */
+static channel_view_t _data_dispatch_build_view(uint16_t* buffer,
+                                                size_t    buffer_size,
+                                                size_t    first_index,
+                                                size_t    data_count,
+                                                uint8_t   sequence_size,
+                                                uint8_t   slot)
 {
-	uint8_t* active_buffer = &current_buffer[adc_index][channel_index];
+	channel_view_t view = {nullptr, 0, 0, 0, 0};
+
+	if (buffer == nullptr)
+		return view;
 
-	*active_buffer = ((*active_buffer) == 0) ? 1 : 0;
-	buffers_data_count[adc_index][channel_index] = 0;
+	uint8_t first_slot = first_index % sequence_size;
+	size_t  offset     = _data_dispatch_get_slot_offset(slot, first_slot, sequence_size);
+
+	if (offset >= data_count)
+		return view;
+
+	view.first = first_index + offset;
+	if (view.first >= buffer_size)
+	{
+		view.first -= buffer_size;
+	}
+
+	view.buffer = buffer;
+	view.stride = sequence_size;
+	view.count  = (data_count - offset + sequence_size - 1) / sequence_size;
+	view.wrap   = buffer_size;
+
+	return view;
 }
 
 /////
 // Public API
 
-void data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions)
+int8_t data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions, bool copy_values)
 {
+	size_t dma_pool_used = 0;
+
 	// Store dispatch method
 	dispatch_type = dispatch_method;
+	copy_to_channel_buffers = copy_values;
+	dual_mode = spin.adc.getDualMode();
 
-	// Prepare arrays for each ADC
-	enabled_channels_count = (uint8_t*)    k_malloc(ADC_COUNT * sizeof(uint8_t));
-	adc_channel_buffers    = (uint16_t****)k_calloc(ADC_COUNT,  sizeof(uint16_t***));
-	buffers_data_count     = (uint32_t**)  k_calloc(ADC_COUNT,  sizeof(uint32_t*));
-	current_buffer         = (uint8_t**)   k_calloc(ADC_COUNT,  sizeof(uint8_t*));
-	peek_memory            = (uint16_t**)  k_calloc(ADC_COUNT,  sizeof(uint16_t*));
+	for (uint8_t channel_index = 0 ; channel_index < MAX_CHANNELS_PER_ADC ; channel_index++)
+	{
+		latest_pairs[channel_index] = (uint32_t)PEEK_NO_VALUE | ((uint32_t)PEEK_NO_VALUE << 16);
+	}
 
 	// Configure DMA 1 channels
 	for (uint8_t adc_num = 1 ; adc_num <= ADC_COUNT ; adc_num++)
 	{
 		uint8_t adc_index = adc_num-1;
-		enabled_channels_count[adc_index] =  spin.adc.getEnabledChannelsCount(adc_num);
+		enabled_channels_count[adc_index] = spin.adc.getEnabledChannelsCount(adc_num);
 
 		if (enabled_channels_count[adc_index] > 0)
 		{
+			// Initialize channels
+			for (int channel_index = 0 ; channel_index < enabled_channels_count[adc_index] ; channel_index++)
+			{
+				latest_values[adc_index][channel_index]    = PEEK_NO_VALUE;
+				sequence_numbers[adc_index][channel_index] = 0;
+			}
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+			previous_dispatch_times[adc_index] = _data_dispatch_get_time();
+#endif
+
+			// In dual mode, ADC 2 values are transferred in ADC 1 DMA buffer
+			uint8_t lane;
+			uint8_t lanes_count = _data_dispatch_get_lanes(adc_index, lane);
+			if (lane != 0)
+				continue;
+
 			// Prepare buffers for DMA
 			size_t dma_buffer_size;
 
@@ -167,13 +576,31 @@ void data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions)
 					// acquired data count computation.
 					dma_buffer_size += enabled_channels_count[adc_index];
 				}
+
+				// When values are only accessed through views, keep room
+				// for a full period of acquisitions after the latest
+				// dispatched block so that it is not overwritten before
+				// the next dispatch.
+				if (copy_to_channel_buffers == false)
+				{
+					dma_buffer_size *= 2;
+				}
 			}
 
+			// Room for values of all ADCs sharing the buffer
+			dma_buffer_size *= lanes_count;
+
+			// Keep next buffer word-aligned
+			size_t dma_buffer_room = dma_buffer_size + (dma_buffer_size & 1);
+			if (dma_buffer_room > DMA_BUFFERS_POOL_SIZE - dma_pool_used)
+				return -1;
+
 			dma_buffer_sizes[adc_index] = dma_buffer_size;
-			dma_main_buffers[adc_index] = (uint16_t*)k_malloc(dma_buffer_size * sizeof(uint16_t));
+			dma_main_buffers[adc_index] = &dma_buffers_pool[dma_pool_used];
+			dma_pool_used += dma_buffer_room;
 			if (dispatch_type == interrupt)
 			{
-				dma_secondary_buffers[adc_index] = dma_main_buffers[adc_index] + enabled_channels_count[adc_index];
+				dma_secondary_buffers[adc_index] = dma_main_buffers[adc_index] + enabled_channels_count[adc_index] * lanes_count;
 			}
 
 			// Initialize DMA
@@ -182,37 +609,50 @@ void data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions)
 			{
 				disable_interrupts = true;
 			}
-			dma_configure_adc_acquisition(adc_num, disable_interrupts, dma_main_buffers[adc_index], dma_buffer_size);
 
-			// Prepare arrays for each channel
-			adc_channel_buffers[adc_index] = (uint16_t***)k_malloc(enabled_channels_count[adc_index] * sizeof(uint16_t**));
-
-			buffers_data_count[adc_index] = (uint32_t*)k_calloc(enabled_channels_count[adc_index], sizeof(uint32_t));
-			current_buffer[adc_index]     = (uint8_t*) k_calloc(enabled_channels_count[adc_index], sizeof(uint8_t));
-			peek_memory[adc_index]        = (uint16_t*)k_calloc(enabled_channels_count[adc_index], sizeof(uint16_t));
-			for (int channel_index = 0 ; channel_index < enabled_channels_count[adc_index] ; channel_index++)
+			int8_t result;
+			if (lanes_count == 1)
 			{
-				// Prepare double buffer
-				adc_channel_buffers[adc_index][channel_index] = (uint16_t**)k_malloc(sizeof(uint16_t*) * 2);
-				adc_channel_buffers[adc_index][channel_index][0] = (uint16_t*)k_malloc(sizeof(uint16_t) * CHANNELS_BUFFERS_SIZE);
-				adc_channel_buffers[adc_index][channel_index][1] = (uint16_t*)k_malloc(sizeof(uint16_t) * CHANNELS_BUFFERS_SIZE);
-
-				peek_memory[adc_index][channel_index] = PEEK_NO_VALUE;
+				result = dma_configure_adc_acquisition(adc_num, disable_interrupts, dma_main_buffers[adc_index], dma_buffer_size);
+			}
+			else
+			{
+				result = dma_configure_dual_adc_acquisition(disable_interrupts, (uint32_t*)dma_main_buffers[adc_index], dma_buffer_size / 2);
 			}
+
+			if (result != 0)
+				return -1;
 		}
 	}
+
+	return 0;
 }
 
 void data_dispatch_do_dispatch(uint8_t adc_num)
 {
 	uint8_t adc_index = adc_num - 1;
+	uint8_t channels_count = enabled_channels_count[adc_index];
 
-	if (enabled_channels_count[adc_index] == 0)
+	if (channels_count == 0)
 		return;
 
+	// In dual mode, ADC 2 values are dispatched along with ADC 1 values
+	uint8_t lane;
+	uint8_t lanes_count = _data_dispatch_get_lanes(adc_index, lane);
+	if (lane != 0)
+		return;
+
+	// Number of values acquired on each sequence trigger
+	uint8_t sequence_size = channels_count * lanes_count;
+
 	uint16_t* dma_buffer = dma_main_buffers[adc_index];
-	if (dma_secondary_buffers[adc_index] != nullptr)
+	size_t    dma_buffer_size;
+	size_t    first_dma_index;
+	size_t    data_count_in_dma_buffer;
+
+	if (dispatch_type == interrupt)
 	{
+		// Each half of DMA buffer holds exactly one sequence
 		if (current_dma_buffer[adc_index] == 0)
 		{
 			current_dma_buffer[adc_index] = 1;
@@ -222,50 +662,122 @@ void data_dispatch_do_dispatch(uint8_t adc_num)
 			dma_buffer = dma_secondary_buffers[adc_index];
 			current_dma_buffer[adc_index] = 0;
 		}
-	}
 
-	size_t data_count_in_dma_buffer;
-	if (dispatch_type == interrupt)
-	{
-		data_count_in_dma_buffer = enabled_channels_count[adc_index];
+		dma_buffer_size          = sequence_size;
+		first_dma_index          = 0;
+		data_count_in_dma_buffer = sequence_size;
 	}
 	else
 	{
-		data_count_in_dma_buffer = dma_get_retreived_data_count(adc_num);
+		dma_buffer_size          = dma_buffer_sizes[adc_index];
+		first_dma_index          = next_dma_buffer_index[adc_index];
+		data_count_in_dma_buffer = dma_get_retreived_data_count(adc_num) * lanes_count;
+
+		size_t next_index = first_dma_index + data_count_in_dma_buffer;
+		if (next_index >= dma_buffer_size)
+		{
+			next_index -= dma_buffer_size;
+		}
+		next_dma_buffer_index[adc_index] = next_index;
 	}
 
-	for (size_t dma_index = 0 ; dma_index < data_count_in_dma_buffer ; dma_index++)
+	if (data_count_in_dma_buffer == 0)
+		return;
+
+	// Dispatch time, in HRTIM master periods
+	sample_timestamp_t now = _data_dispatch_get_time();
+
+	// Remember dispatched block for views
+	for (uint8_t value_adc_index = adc_index ; value_adc_index < adc_index + lanes_count ; value_adc_index++)
 	{
-		// Copy data
-		size_t dma_buffer_index;
-		if (dispatch_type == interrupt)
+		dispatched_buffer[value_adc_index]      = dma_buffer;
+		dispatched_buffer_size[value_adc_index] = dma_buffer_size;
+		dispatched_first_index[value_adc_index] = first_dma_index;
+		dispatched_count[value_adc_index]       = data_count_in_dma_buffer;
+	}
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+	if (copy_to_channel_buffers == true)
+	{
+		_data_dispatch_update_block_time(adc_index, now);
+		if (lanes_count == 2)
 		{
-			dma_buffer_index = dma_index % enabled_channels_count[adc_index];
+			// Simultaneous values share the same time span
+			block_starts[adc_index+1]    = block_starts[adc_index];
+			block_durations[adc_index+1] = block_durations[adc_index];
 		}
-		else
+	}
+#endif
+
+	if (lanes_count == 2)
+	{
+		_data_dispatch_update_pairs(dma_buffer, dma_buffer_size, first_dma_index, data_count_in_dma_buffer, sequence_size);
+	}
+
+	// DMA buffer size being a multiple of the sequence size, the
+	// position of a value in the sequence only depends on its index
+	// in the buffer. Values of ADCs sharing the buffer are interleaved.
+	uint8_t first_slot = first_dma_index % sequence_size;
+
+	for (uint8_t slot = 0 ; slot < sequence_size ; slot++)
+	{
+		uint8_t value_adc_index = adc_index + slot % lanes_count;
+		uint8_t channel_index   = slot / lanes_count;
+
+		// Offset from first value to dispatch to first value of this channel
+		size_t offset = _data_dispatch_get_slot_offset(slot, first_slot, sequence_size);
+
+		if (offset >= data_count_in_dma_buffer)
+			continue;
+
+		size_t values_count = (data_count_in_dma_buffer - offset + sequence_size - 1) / sequence_size;
+
+		// Sequence number and period are read together by accessors
+		unsigned int key = irq_lock();
+		sequence_numbers[value_adc_index][channel_index] += values_count;
+		latest_periods[value_adc_index][channel_index]    = now.period;
+		irq_unlock(key);
+
+		bool filtered = (channel_filters[value_adc_index][channel_index].type != filter_none);
+		bool with_stats = (channel_stats[value_adc_index][channel_index].window != 0);
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+		int8_t capture_slot = data_capture_get_recording_slot(value_adc_index, channel_index);
+		bool   captured     = (capture_slot >= 0);
+#else
+		bool   captured     = false;
+#endif
+
+		if ( (copy_to_channel_buffers == false) && (filtered == false) && (with_stats == false) && (captured == false) )
+			continue;
+
+		size_t dma_index = first_dma_index + offset;
+		if (dma_index >= dma_buffer_size)
 		{
-			static size_t next_dma_buffer_index[ADC_COUNT] = {0};
+			dma_index -= dma_buffer_size;
+		}
 
-			dma_buffer_index = next_dma_buffer_index[adc_index];
-			if (next_dma_buffer_index[adc_index] < dma_buffer_sizes[adc_index]-1)
-			{
-				next_dma_buffer_index[adc_index]++;
-			}
-			else
-			{
-				next_dma_buffer_index[adc_index] = 0;
-			}
+		if (copy_to_channel_buffers == true)
+		{
+			_data_dispatch_copy_channel(value_adc_index, channel_index, dma_buffer, dma_buffer_size, dma_index, sequence_size, values_count);
 		}
 
-		// Get info on buffer
-		size_t channel_index = dma_buffer_index % enabled_channels_count[adc_index];
-		uint16_t* active_buffer = _data_dispatch_get_buffer(adc_index, channel_index);
-		uint32_t  current_count = _data_dispatch_get_count(adc_index, channel_index);
+		if (filtered == true)
+		{
+			_data_dispatch_filter_channel(value_adc_index, channel_index, dma_buffer, dma_buffer_size, dma_index, sequence_size, values_count);
+		}
 
-		active_buffer[current_count] = dma_buffer[dma_buffer_index];
+		if (with_stats == true)
+		{
+			_data_dispatch_stats_channel(value_adc_index, channel_index, dma_buffer, dma_buffer_size, dma_index, sequence_size, values_count);
+		}
 
-		// Increment count
-		_data_dispatch_increment_count(adc_index, channel_index);
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+		if (captured == true)
+		{
+			data_capture_push(capture_slot, dma_buffer, dma_buffer_size, dma_index, sequence_size, values_count);
+		}
+#endif
 	}
 }
 
@@ -281,59 +793,360 @@ void data_dispatch_do_full_dispatch()
 /////
 // Accessors
 
-uint16_t* data_dispatch_get_acquired_values(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired)
+uint16_t* data_dispatch_get_acquired_values(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired, uint8_t cursor)
 {
 	// Prepare default value
 	number_of_values_acquired = 0;
 
 	// Check index
 	uint8_t adc_index = adc_number-1;
-	if (adc_index >= ADC_COUNT)
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) || (cursor >= MAX_CURSORS_PER_CHANNEL) )
 		return nullptr;
 
-	// Get and check data count
-	uint8_t channel_index = channel_rank-1;
-	uint32_t current_count = _data_dispatch_get_count(adc_index, channel_index);
-	if (current_count == 0)
+	if ( (cursor != 0) && (atomic_test_bit(&cursor_registered[adc_index][channel_index], cursor) == false) )
 		return nullptr;
 
-	// Get and swap buffer
-	uint16_t* active_buffer = _data_dispatch_get_buffer(adc_index, channel_index);
-	_data_dispatch_swap_buffers(adc_index, channel_index);
+	// Get head before reading values it publishes
+	uint32_t head = ring_heads[adc_index][channel_index];
+	__DMB();
 
-	// Retain latest value for peek() functions
-	if (current_count > 0)
+	uint32_t tail;
+	if (cursor_active[adc_index][channel_index][cursor] == false)
 	{
-		peek_memory[adc_index][channel_index] = active_buffer[current_count-1];
+		// First read: cursor starts at current position
+		tail = head;
+		cursor_active[adc_index][channel_index][cursor] = true;
+	}
+	else
+	{
+		tail = cursor_tails[adc_index][channel_index][cursor];
+	}
+
+	uint32_t current_count = head - tail;
+	if (current_count > CHANNELS_BUFFERS_SIZE)
+	{
+		// Cursor fell behind: oldest values have been overwritten
+		cursor_overruns[adc_index][channel_index][cursor] += current_count - CHANNELS_BUFFERS_SIZE;
+		current_count = CHANNELS_BUFFERS_SIZE;
+		tail          = head - CHANNELS_BUFFERS_SIZE;
 	}
 
+	cursor_tails[adc_index][channel_index][cursor] = head;
+
+	if (current_count == 0)
+		return nullptr;
+
 	// Return data
 	number_of_values_acquired = current_count;
-	return active_buffer;
+	return &channel_rings[adc_index][channel_index][tail & CHANNELS_BUFFERS_MASK];
 }
 
-uint16_t data_dispatch_peek_acquired_value(uint8_t adc_number, uint8_t channel_rank)
+uint16_t* data_dispatch_get_acquired_values_timed(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps, uint8_t cursor)
+{
+	timestamps = nullptr;
+
+	uint16_t* values = data_dispatch_get_acquired_values(adc_number, channel_rank, number_of_values_acquired, cursor);
+
+#ifdef CONFIG_OWNTECH_DATA_API_TIMESTAMPS
+	if (values != nullptr)
+	{
+		uint8_t adc_index     = adc_number-1;
+		uint8_t channel_index = channel_rank-1;
+		size_t  ring_index    = values - channel_rings[adc_index][channel_index];
+		timestamps = &channel_timestamps[adc_index][channel_index][ring_index];
+	}
+#endif
+
+	return values;
+}
+
+int8_t data_dispatch_register_cursor(uint8_t adc_number, uint8_t channel_rank)
 {
 	uint8_t adc_index = adc_number-1;
 	uint8_t channel_index = channel_rank-1;
-	if (adc_index < ADC_COUNT)
-	{
-		// Get info on buffer
-		uint16_t* active_buffer = _data_dispatch_get_buffer(adc_index, channel_index);
-		uint32_t  current_count = _data_dispatch_get_count(adc_index, channel_index);
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
 
-		// Return data
-		if (current_count > 0)
+	// Cursor 0 is reserved to default reader
+	for (uint8_t cursor = 1 ; cursor < MAX_CURSORS_PER_CHANNEL ; cursor++)
+	{
+		if (atomic_test_and_set_bit(&cursor_registered[adc_index][channel_index], cursor) == false)
 		{
-			return active_buffer[current_count-1];
+			cursor_active[adc_index][channel_index][cursor]   = false;
+			cursor_overruns[adc_index][channel_index][cursor] = 0;
+			return cursor;
 		}
-		else
+	}
+
+	return -1;
+}
+
+void data_dispatch_release_cursor(uint8_t adc_number, uint8_t channel_rank, uint8_t cursor)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) || (cursor >= MAX_CURSORS_PER_CHANNEL) )
+		return;
+
+	cursor_active[adc_index][channel_index][cursor] = false;
+	if (cursor != 0)
+	{
+		atomic_clear_bit(&cursor_registered[adc_index][channel_index], cursor);
+	}
+}
+
+uint16_t data_dispatch_peek_acquired_value(uint8_t adc_number, uint8_t channel_rank)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return 0;
+
+	if (copy_to_channel_buffers == false)
+	{
+		channel_view_t view = data_dispatch_get_channel_view(adc_number, channel_rank);
+		if (view.count == 0)
 		{
-			return peek_memory[adc_index][channel_index];
+			return PEEK_NO_VALUE;
 		}
+		return view[view.count-1];
 	}
-	else
-	{
+
+	return latest_values[adc_index][channel_index];
+}
+
+uint32_t data_dispatch_get_overrun_count(uint8_t adc_number, uint8_t channel_rank, uint8_t cursor)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) || (cursor >= MAX_CURSORS_PER_CHANNEL) )
 		return 0;
+
+	return cursor_overruns[adc_index][channel_index][cursor];
+}
+
+int8_t data_dispatch_get_sequence_info(uint8_t adc_number, uint8_t channel_rank, uint32_t& sequence_number, uint32_t& age)
+{
+	sequence_number = 0;
+	age             = 0;
+
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= enabled_channels_count[adc_index]) )
+		return -1;
+
+	sample_timestamp_t now = _data_dispatch_get_time();
+
+	unsigned int key = irq_lock();
+	uint32_t sequence = sequence_numbers[adc_index][channel_index];
+	uint32_t period   = latest_periods[adc_index][channel_index];
+	irq_unlock(key);
+
+	if (sequence == 0)
+		return -1;
+
+	sequence_number = sequence;
+	age             = now.period - period;
+
+	return 0;
+}
+
+channel_view_t data_dispatch_get_channel_view(uint8_t adc_number, uint8_t channel_rank)
+{
+	channel_view_t view = {nullptr, 0, 0, 0, 0};
+
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= enabled_channels_count[adc_index]) )
+		return view;
+
+	// Get a consistent copy of the latest dispatched block,
+	// as it may be updated by DMA interrupt in Interrupt mode.
+	unsigned int key = irq_lock();
+	uint16_t* buffer      = dispatched_buffer[adc_index];
+	size_t    buffer_size = dispatched_buffer_size[adc_index];
+	size_t    first_index = dispatched_first_index[adc_index];
+	size_t    data_count  = dispatched_count[adc_index];
+	irq_unlock(key);
+
+	uint8_t lane;
+	uint8_t lanes_count   = _data_dispatch_get_lanes(adc_index, lane);
+	uint8_t sequence_size = enabled_channels_count[adc_index] * lanes_count;
+
+	return _data_dispatch_build_view(buffer, buffer_size, first_index, data_count, sequence_size, channel_index*lanes_count + lane);
+}
+
+int8_t data_dispatch_peek_acquired_pair(uint8_t channel_rank, uint16_t& adc1_value, uint16_t& adc2_value)
+{
+	uint8_t channel_index = channel_rank-1;
+	if ( (dual_mode == false) || (channel_index >= enabled_channels_count[0]) )
+		return -1;
+
+	// Single read: both values come from the same conversion
+	uint32_t pair = latest_pairs[channel_index];
+
+	adc1_value = (uint16_t)(pair & 0xFFFF);
+	adc2_value = (uint16_t)(pair >> 16);
+
+	if ( (adc1_value == PEEK_NO_VALUE) || (adc2_value == PEEK_NO_VALUE) )
+		return -1;
+
+	return 0;
+}
+
+int8_t data_dispatch_get_pair_views(uint8_t channel_rank, channel_view_t& adc1_view, channel_view_t& adc2_view)
+{
+	adc1_view = {nullptr, 0, 0, 0, 0};
+	adc2_view = {nullptr, 0, 0, 0, 0};
+
+	uint8_t channel_index = channel_rank-1;
+	if ( (dual_mode == false) || (channel_index >= enabled_channels_count[0]) )
+		return -1;
+
+	// Both views are built from the same dispatched block
+	unsigned int key = irq_lock();
+	uint16_t* buffer      = dispatched_buffer[0];
+	size_t    buffer_size = dispatched_buffer_size[0];
+	size_t    first_index = dispatched_first_index[0];
+	size_t    data_count  = dispatched_count[0];
+	irq_unlock(key);
+
+	uint8_t sequence_size = enabled_channels_count[0] * 2;
+
+	adc1_view = _data_dispatch_build_view(buffer, buffer_size, first_index, data_count, sequence_size, channel_index*2);
+	adc2_view = _data_dispatch_build_view(buffer, buffer_size, first_index, data_count, sequence_size, channel_index*2 + 1);
+
+	if (adc1_view.count == 0)
+		return -1;
+
+	return 0;
+}
+
+int8_t data_dispatch_set_filter(uint8_t adc_number, uint8_t channel_rank, filter_type_t type, uint32_t param1, uint32_t param2)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
+
+	// Filter is configured on a local copy so that
+	// dispatch never sees a partially configured filter.
+	filter_state_t filter;
+	int8_t result;
+	switch (type)
+	{
+		case filter_boxcar:
+			result = data_filter_configure_boxcar(&filter, param1);
+			break;
+		case filter_cic:
+			result = data_filter_configure_cic(&filter, (uint8_t)param1, param2);
+			break;
+		case filter_iir:
+			result = data_filter_configure_iir(&filter, (uint8_t)param1);
+			break;
+		default:
+			data_filter_disable(&filter);
+			result = 0;
+			break;
 	}
+
+	if (result != 0)
+		return result;
+
+	unsigned int key = irq_lock();
+	channel_filters[adc_index][channel_index] = filter;
+	irq_unlock(key);
+
+	return 0;
 }
+
+int8_t data_dispatch_get_filter_output(uint8_t adc_number, uint8_t channel_rank, uint32_t& output)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
+
+	filter_state_t* filter = &channel_filters[adc_index][channel_index];
+	if (filter->output_valid == false)
+		return -1;
+
+	output = filter->output;
+	return 0;
+}
+
+int8_t data_dispatch_set_stats_window(uint8_t adc_number, uint8_t channel_rank, uint32_t window)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
+
+	// Statistics are configured on a local copy so that
+	// dispatch never sees partially reset accumulators.
+	stats_state_t stats;
+	int8_t result = data_stats_configure(&stats, window);
+	if (result != 0)
+		return result;
+
+	unsigned int key = irq_lock();
+	channel_stats[adc_index][channel_index] = stats;
+	irq_unlock(key);
+
+	return 0;
+}
+
+int8_t data_dispatch_get_stats(uint8_t adc_number, uint8_t channel_rank, stats_snapshot_t& snapshot)
+{
+	uint8_t adc_index = adc_number-1;
+	uint8_t channel_index = channel_rank-1;
+	if ( (adc_index >= ADC_COUNT) || (channel_index >= MAX_CHANNELS_PER_ADC) )
+		return -1;
+
+	// Snapshot is published by dispatch: get a consistent copy
+	unsigned int key = irq_lock();
+	snapshot = channel_stats[adc_index][channel_index].snapshot;
+	irq_unlock(key);
+
+	if (snapshot.window_number == 0)
+		return -1;
+
+	return 0;
+}
+
+
+#ifdef CONFIG_OWNTECH_DATA_API_BENCHMARK
+
+/////
+// Benchmark hooks
+
+void data_dispatch_benchmark_copy(uint16_t* dma_buffer, size_t dma_buffer_size, uint8_t sequence_size)
+{
+	// Same per-channel copy as dispatch, ADC 1 channels in sequence order
+	size_t values_count = dma_buffer_size / sequence_size;
+
+	for (uint8_t slot = 0 ; slot < sequence_size ; slot++)
+	{
+		_data_dispatch_copy_channel(0, slot, dma_buffer, dma_buffer_size, slot, sequence_size, values_count);
+	}
+}
+
+void data_dispatch_benchmark_reset(uint8_t sequence_size)
+{
+	unsigned int key = irq_lock();
+
+	for (uint8_t channel_index = 0 ; channel_index < sequence_size ; channel_index++)
+	{
+		ring_heads[0][channel_index]    = 0;
+		latest_values[0][channel_index] = PEEK_NO_VALUE;
+		for (uint8_t cursor = 0 ; cursor < MAX_CURSORS_PER_CHANNEL ; cursor++)
+		{
+			cursor_active[0][channel_index][cursor] = false;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+#endif // CONFIG_OWNTECH_DATA_API_BENCHMARK
@@ -26,9 +26,13 @@
  * acquired data from DMA buffers to per-channel buffers.
  * User can then request the data of a specific channel.
  *
- * It uses double-buffering, holding 2 buffers for each
- * enabled channel of each ADC, one being filled and one
- * made available to the user.
+ * Each enabled channel of each ADC has a lock-free ring
+ * buffer: dispatch is the single producer, and multiple
+ * readers can each register their own read cursor on the
+ * ring. Dispatch never waits for readers: each cursor sees
+ * every value as long as it reads the ring before it wraps,
+ * and a cursor that falls behind only loses its own oldest
+ * values.
  */
 
 #ifndef DATA_DISPATCH_H_
@@ -37,6 +41,11 @@
 
 // Stdlib
 #include <stdint.h>
+#include <stddef.h>
+
+// Current module private headers
+#include "data_filter.h"
+#include "data_stats.h"
 
 
 const uint16_t PEEK_NO_VALUE = 0xFFFF;
@@ -46,6 +55,47 @@ const uint16_t PEEK_NO_VALUE = 0xFFFF;
  */
 typedef enum {task, interrupt} dispatch_t;
 
+/**
+ * Timestamp of an acquired value, in HRTIM master time.
+ */
+typedef struct
+{
+	uint32_t period; // Number of HRTIM master periods since acquisition start
+	uint16_t offset; // HRTIM master counter value within the period
+} sample_timestamp_t;
+
+/**
+ * Strided view on the values of a single channel,
+ * pointing directly in the circular DMA buffer.
+ * Values of a channel are interleaved with values of
+ * other channels of the same ADC, thus the stride is
+ * the number of enabled channels on the ADC. In dual mode,
+ * ADC 1 and ADC 2 values are also interleaved with each
+ * other, and the stride is doubled.
+ */
+typedef struct channel_view_t
+{
+	const uint16_t* buffer; // Base address of the circular DMA buffer
+	size_t          first;  // Index in buffer of the first value of the view
+	size_t          stride; // Distance between two values of the channel
+	size_t          count;  // Number of values in the view
+	size_t          wrap;   // Size of the buffer, at which indexes wrap
+
+	/**
+	 * @brief Access the i-th value of the view,
+	 *        i being less than count.
+	 */
+	uint16_t operator[](size_t i) const
+	{
+		size_t index = this->first + i*this->stride;
+		if (index >= this->wrap)
+		{
+			index -= this->wrap;
+		}
+		return this->buffer[index];
+	}
+} channel_view_t;
+
 /**
  * @brief Init function to be called first.
  *
@@ -55,8 +105,17 @@ typedef enum {task, interrupt} dispatch_t;
  *        this value represents the number of acquisitions
  *        that are done between two execution of the
  *        task. Ignored if dispatch is done on interrupt.
+ * @param copy_values Indicates if values are copied from
+ *        DMA buffers to per-channel buffers on dispatch.
+ *        When false, values are only accessible using
+ *        channel views.
+ *
+ * @return 0 if dispatch was initialized, -1 if DMA buffers
+ *         required by the configuration exceed the pool
+ *         size set by CONFIG_OWNTECH_DATA_API_DMA_BUFFERS_SIZE,
+ *         or if no DMA channel is available for an ADC.
  */
-void data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions);
+int8_t data_dispatch_init(dispatch_t dispatch_method, uint32_t repetitions, bool copy_values = true);
 
 /**
  * @brief Dispatch function: gets the readings and store them
@@ -86,12 +145,72 @@ void data_dispatch_do_full_dispatch();
  * @param  number_of_values_acquired Output parameter:
  *         address to a variable that will be updated
  *         by the function with the data count.
+ * @param  cursor Cursor of the reader, as returned by
+ *         data_dispatch_register_cursor(). Default cursor
+ *         is 0. A cursor becomes active on its first call,
+ *         and only values acquired after that are provided.
+ * @return Buffer containing the available data, holding at
+ *         most CONFIG_OWNTECH_DATA_API_CHANNEL_BUFFER_SIZE
+ *         values: if more values were acquired since previous
+ *         call, oldest ones are lost and counted as overrun.
+ *         Values of the buffer are overwritten once the
+ *         ring wraps, i.e. after buffer size minus count
+ *         new values have been dispatched.
+ *         This function must always be called from the
+ *         same context for a given cursor.
+ */
+uint16_t* data_dispatch_get_acquired_values(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired, uint8_t cursor = 0);
+
+/**
+ * @brief  Obtain data for a specific channel along with the
+ *         timestamps of the values. This function behaves as
+ *         data_dispatch_get_acquired_values().
+ *
+ * @note   Timestamps are only recorded when
+ *         CONFIG_OWNTECH_DATA_API_TIMESTAMPS is set.
+ *         Values of a dispatched block are stamped by evenly
+ *         spreading them between the previous dispatch of
+ *         their ADC and the current one.
+ *
+ * @param  adc_number Number of the ADC from which to
+ *         obtain data.
+ * @param  channel_rank Rank of the channel from which
+ *         to obtain data.
+ * @param  number_of_values_acquired Output parameter:
+ *         address to a variable that will be updated
+ *         by the function with the data count.
+ * @param  timestamps Output parameter: updated with a buffer
+ *         holding the timestamp of each value, or nullptr if
+ *         timestamps are not recorded.
+ * @param  cursor Cursor of the reader.
  * @return Buffer containing the available data.
- *         Note that the returned buffer is invalidated
- *         by further calls to the function with same
- *         adc number/channel rank.
  */
-uint16_t* data_dispatch_get_acquired_values(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired);
+uint16_t* data_dispatch_get_acquired_values_timed(uint8_t adc_number, uint8_t channel_rank, uint32_t& number_of_values_acquired, const sample_timestamp_t*& timestamps, uint8_t cursor = 0);
+
+/**
+ * @brief  Register a new read cursor on a channel.
+ *         This function can be called from any context.
+ *
+ * @note   A cursor that does not read values fast enough
+ *         loses its oldest values, which are counted on
+ *         its own overrun counter. Other cursors of the
+ *         channel are not affected.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @return Cursor number, or -1 if no cursor is available.
+ */
+int8_t data_dispatch_register_cursor(uint8_t adc_number, uint8_t channel_rank);
+
+/**
+ * @brief  Release a read cursor on a channel. For the default
+ *         cursor, this only deactivates it until its next read.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  cursor Cursor to release.
+ */
+void data_dispatch_release_cursor(uint8_t adc_number, uint8_t channel_rank, uint8_t cursor);
 
 /**
  * @brief  Peek data for a specific channel:
@@ -108,5 +227,156 @@ uint16_t* data_dispatch_get_acquired_values(uint8_t adc_number, uint8_t channel_
  */
 uint16_t data_dispatch_peek_acquired_value(uint8_t adc_number, uint8_t channel_rank);
 
+/**
+ * @brief  Get the number of values that a cursor lost because
+ *         it fell more than the ring buffer size behind dispatch.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  cursor Cursor of the reader. Default cursor is 0.
+ * @return Number of lost values since start for the default
+ *         cursor, since registration for other cursors.
+ */
+uint32_t data_dispatch_get_overrun_count(uint8_t adc_number, uint8_t channel_rank, uint8_t cursor = 0);
+
+/**
+ * @brief  Get the sequence number and age of the latest value
+ *         dispatched for a specific channel.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  sequence_number Output parameter: number of values
+ *         acquired on the channel since start, including the
+ *         latest one. It increases on each acquisition, even
+ *         when values are lost on overrun.
+ * @param  age Output parameter: number of HRTIM master periods
+ *         elapsed since the latest value was dispatched.
+ *         Stays at 0 if HRTIM master is not configured.
+ * @return 0 if a value has been dispatched, -1 otherwise.
+ */
+int8_t data_dispatch_get_sequence_info(uint8_t adc_number, uint8_t channel_rank, uint32_t& sequence_number, uint32_t& age);
+
+/**
+ * @brief  Obtain a view on the values of a specific channel
+ *         that have been acquired between the two latest
+ *         dispatches, directly in the DMA buffer.
+ *         This does not alter the per-channel buffers.
+ *
+ * @note   In Task mode, DMA buffer is large enough for the
+ *         view to remain valid until the next dispatch when
+ *         values are not copied to channel buffers. In Interrupt
+ *         mode, the view only holds the latest value.
+ *
+ * @param  adc_number Number of the ADC from which to
+ *         obtain data.
+ * @param  channel_rank Rank of the channel from which
+ *         to obtain data.
+ * @return View on the channel values. View count is 0
+ *         if no value was acquired.
+ */
+channel_view_t data_dispatch_get_channel_view(uint8_t adc_number, uint8_t channel_rank);
+
+/**
+ * @brief  Peek the latest pair of simultaneous values
+ *         of a given rank on ADC 1 and ADC 2 in dual mode.
+ *         Both values are guaranteed to come from the
+ *         same conversion.
+ *
+ * @param  channel_rank Rank of the channels on both ADCs.
+ * @param  adc1_value Output parameter: ADC 1 value.
+ * @param  adc2_value Output parameter: ADC 2 value.
+ * @return 0 if a pair is available, -1 if dual mode is
+ *         not active, rank is invalid or no value was acquired.
+ */
+int8_t data_dispatch_peek_acquired_pair(uint8_t channel_rank, uint16_t& adc1_value, uint16_t& adc2_value);
+
+/**
+ * @brief  Obtain views on the values of a given rank on ADC 1
+ *         and ADC 2 in dual mode, built from the same dispatched
+ *         block: both views have the same count, and values
+ *         at the same index in both views are simultaneous.
+ *
+ * @param  channel_rank Rank of the channels on both ADCs.
+ * @param  adc1_view Output parameter: view on ADC 1 values.
+ * @param  adc2_view Output parameter: view on ADC 2 values.
+ * @return 0 if views hold values, -1 otherwise.
+ */
+int8_t data_dispatch_get_pair_views(uint8_t channel_rank, channel_view_t& adc1_view, channel_view_t& adc2_view);
+
+/**
+ * @brief  Configure the filter applied to a specific channel
+ *         on dispatch. Filter is fed with all acquired values,
+ *         whether they are copied to channel buffers or not.
+ *         Any previous filter state is discarded.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  type Type of filter, or filter_none to disable filtering.
+ * @param  param1 Boxcar: length, CIC: order, IIR: shift.
+ * @param  param2 CIC: decimation ratio. Unused otherwise.
+ * @return 0 if filter was configured, -1 if parameters are invalid.
+ */
+int8_t data_dispatch_set_filter(uint8_t adc_number, uint8_t channel_rank, filter_type_t type, uint32_t param1, uint32_t param2 = 0);
+
+/**
+ * @brief  Get the latest output of a channel filter.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  output Output parameter: latest filter output,
+ *         as a raw value in Q16 format.
+ * @return 0 if an output is available, -1 otherwise.
+ */
+int8_t data_dispatch_get_filter_output(uint8_t adc_number, uint8_t channel_rank, uint32_t& output);
+
+/**
+ * @brief  Configure the running statistics of a specific channel.
+ *         Statistics are accumulated on dispatch over windows of
+ *         fixed length, whether values are copied to channel
+ *         buffers or not. Any previous accumulation is discarded.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  window Number of values in a window, up to
+ *         STATS_MAX_WINDOW, or 0 to disable statistics.
+ * @return 0 if statistics were configured, -1 if parameters are invalid.
+ */
+int8_t data_dispatch_set_stats_window(uint8_t adc_number, uint8_t channel_rank, uint32_t window);
+
+/**
+ * @brief  Get a consistent snapshot of the statistics
+ *         of the latest completed window of a channel.
+ *
+ * @param  adc_number Number of the ADC.
+ * @param  channel_rank Rank of the channel.
+ * @param  snapshot Output parameter: statistics of the window.
+ * @return 0 if a window was completed, -1 otherwise.
+ */
+int8_t data_dispatch_get_stats(uint8_t adc_number, uint8_t channel_rank, stats_snapshot_t& snapshot);
+
+#ifdef CONFIG_OWNTECH_DATA_API_BENCHMARK
+
+/**
+ * @brief  Benchmark hook: copy a DMA block to the rings of
+ *         ADC 1 channels, the same way dispatch does.
+ *
+ * @param  dma_buffer DMA block, holding values of sequence_size
+ *         channels interleaved.
+ * @param  dma_buffer_size Number of values in the block, a
+ *         multiple of the sequence size.
+ * @param  sequence_size Number of channels in the sequence.
+ */
+void data_dispatch_benchmark_copy(uint16_t* dma_buffer, size_t dma_buffer_size, uint8_t sequence_size);
+
+/**
+ * @brief  Benchmark hook: empty the rings written by
+ *         data_dispatch_benchmark_copy().
+ *
+ * @param  sequence_size Number of channels in the sequence.
+ */
+void data_dispatch_benchmark_reset(uint8_t sequence_size);
+
+#endif
+
 
 #endif // DATA_DISPATCH_H_
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+
+// Stdlib
+#include <string.h>
+
+// Current file header
+#include "data_filter.h"
+
+
+/////
+// Private functions
+
+static void _data_filter_reset(filter_state_t* filter)
+{
+	filter->type         = filter_none;
+	filter->count        = 0;
+	filter->iir_state    = 0;
+	filter->output_valid = false;
+	memset(filter->integrators, 0, sizeof(filter->integrators));
+	memset(filter->combs, 0, sizeof(filter->combs));
+}
+
+
+/////
+// Public functions
+
+int8_t data_filter_configure_boxcar(filter_state_t* filter, uint32_t length)
+{
+	if ( (length < 2) || (length > UINT16_MAX) )
+		return -1;
+
+	_data_filter_reset(filter);
+
+	filter->decimation = length;
+	filter->reciprocal = (uint32_t)(((uint64_t)1 << 32) / length);
+	filter->type       = filter_boxcar;
+
+	return 0;
+}
+
+int8_t data_filter_configure_cic(filter_state_t* filter, uint8_t order, uint32_t decimation)
+{
+	if ( (order == 0) || (order > FILTER_MAX_CIC_ORDER) || (decimation < 2) )
+		return -1;
+
+	// CIC gain is decimation^order. With 16-bit inputs,
+	// gain must not exceed 2^16 to fit in 32-bit registers.
+	uint64_t gain = 1;
+	for (uint8_t stage = 0 ; stage < order ; stage++)
+	{
+		gain *= decimation;
+		if (gain > ((uint64_t)1 << 16))
+			return -1;
+	}
+
+	_data_filter_reset(filter);
+
+	filter->order      = order;
+	filter->decimation = decimation;
+	filter->reciprocal = (uint32_t)(((uint64_t)1 << 32) / gain);
+	filter->type       = filter_cic;
+
+	return 0;
+}
+
+int8_t data_filter_configure_iir(filter_state_t* filter, uint8_t shift)
+{
+	if ( (shift == 0) || (shift > 15) )
+		return -1;
+
+	_data_filter_reset(filter);
+
+	filter->shift = shift;
+	filter->type  = filter_iir;
+
+	return 0;
+}
+
+void data_filter_disable(filter_state_t* filter)
+{
+	_data_filter_reset(filter);
+}
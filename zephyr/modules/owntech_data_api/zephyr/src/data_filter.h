@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Integer filters applied to channel values as they
+ *         are dispatched. All filters only use integer arithmetic
+ *         so that their cost in dispatch is fixed.
+ *
+ *         Filter output is expressed as a raw value in Q16 format,
+ *         i.e. raw value multiplied by 65536.
+ */
+
+#ifndef DATA_FILTER_H_
+#define DATA_FILTER_H_
+
+
+// Stdlib
+#include <stdint.h>
+
+// ARM CMSIS library
+#include <arm_math.h>
+
+
+/////
+// Type definitions
+
+typedef enum : uint8_t
+{
+	filter_none = 0,
+	filter_boxcar,
+	filter_cic,
+	filter_iir
+} filter_type_t;
+
+static const uint8_t FILTER_MAX_CIC_ORDER = 3;
+
+typedef struct
+{
+	filter_type_t type;
+	uint8_t  order;                              // CIC: number of stages
+	uint8_t  shift;                              // IIR: smoothing factor is 2^-shift
+	uint32_t decimation;                         // Boxcar: length, CIC: decimation ratio
+	uint32_t count;                              // Values accumulated in current block
+	uint32_t reciprocal;                         // 2^32 divided by block gain
+	uint32_t integrators[FILTER_MAX_CIC_ORDER];  // Boxcar accumulator / CIC integrators
+	uint32_t combs[FILTER_MAX_CIC_ORDER];        // CIC comb delays
+	int32_t  iir_state;                          // IIR state in Q14 format
+
+	volatile uint32_t output;                    // Latest output, raw value in Q16 format
+	volatile bool     output_valid;              // Indicates an output is available
+} filter_state_t;
+
+
+/////
+// API
+
+/**
+ * @brief Configure a filter as a boxcar average: each output
+ *        is the average of a block of length values. Output
+ *        rate is thus divided by length.
+ *
+ * @param filter Filter to configure.
+ * @param length Number of values averaged, from 2 to 65535.
+ *
+ * @return 0 if filter was configured, -1 if parameters are invalid.
+ */
+int8_t data_filter_configure_boxcar(filter_state_t* filter, uint32_t length);
+
+/**
+ * @brief Configure a filter as a CIC decimator.
+ *
+ * @param filter Filter to configure.
+ * @param order Number of integrator/comb stages, from 1 to 3.
+ * @param decimation Decimation ratio. decimation^order
+ *        must be between 2 and 65536 to avoid overflow.
+ *
+ * @return 0 if filter was configured, -1 if parameters are invalid.
+ */
+int8_t data_filter_configure_cic(filter_state_t* filter, uint8_t order, uint32_t decimation);
+
+/**
+ * @brief Configure a filter as a first-order IIR low-pass filter:
+ *        y += (x - y) / 2^shift, with an output for each value.
+ *
+ * @param filter Filter to configure.
+ * @param shift Smoothing factor, from 1 to 15.
+ *
+ * @return 0 if filter was configured, -1 if parameters are invalid.
+ */
+int8_t data_filter_configure_iir(filter_state_t* filter, uint8_t shift);
+
+/**
+ * @brief Disable a filter.
+ *
+ * @param filter Filter to disable.
+ */
+void data_filter_disable(filter_state_t* filter);
+
+/**
+ * @brief Push a new value in a filter.
+ *        This function is called by dispatch for each value.
+ *
+ * @param filter Filter to push the value into.
+ * @param value  Raw value.
+ */
+__STATIC_FORCEINLINE void data_filter_push(filter_state_t* filter, uint16_t value)
+{
+	switch (filter->type)
+	{
+		case filter_boxcar:
+			filter->integrators[0] += value;
+			filter->count++;
+			if (filter->count == filter->decimation)
+			{
+				filter->output = ((uint64_t)filter->integrators[0] * filter->reciprocal) >> 16;
+				filter->output_valid = true;
+				filter->integrators[0] = 0;
+				filter->count = 0;
+			}
+			break;
+		case filter_cic:
+		{
+			// Integrators run at input rate, with modular arithmetic
+			uint32_t stage_input = value;
+			for (uint8_t stage = 0 ; stage < filter->order ; stage++)
+			{
+				filter->integrators[stage] += stage_input;
+				stage_input = filter->integrators[stage];
+			}
+
+			// Combs run at output rate
+			filter->count++;
+			if (filter->count == filter->decimation)
+			{
+				for (uint8_t stage = 0 ; stage < filter->order ; stage++)
+				{
+					uint32_t delayed = filter->combs[stage];
+					filter->combs[stage] = stage_input;
+					stage_input -= delayed;
+				}
+				filter->output = ((uint64_t)stage_input * filter->reciprocal) >> 16;
+				filter->output_valid = true;
+				filter->count = 0;
+			}
+			break;
+		}
+		case filter_iir:
+			filter->iir_state += (((int32_t)value << 14) - filter->iir_state) >> filter->shift;
+			filter->output = (uint32_t)filter->iir_state << 2;
+			filter->output_valid = true;
+			break;
+		default:
+			break;
+	}
+}
+
+
+#endif // DATA_FILTER_H_
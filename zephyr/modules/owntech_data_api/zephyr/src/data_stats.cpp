@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+
+// Current file header
+#include "data_stats.h"
+
+
+/////
+// Public functions
+
+int8_t data_stats_configure(stats_state_t* stats, uint32_t window)
+{
+	if (window > STATS_MAX_WINDOW)
+		return -1;
+
+	stats->window      = window;
+	stats->min         = UINT16_MAX;
+	stats->max         = 0;
+	stats->count       = 0;
+	stats->sum         = 0;
+	stats->sum_squares = 0;
+
+	stats->snapshot = {0, 0, 0, 0, 0, 0};
+
+	return 0;
+}
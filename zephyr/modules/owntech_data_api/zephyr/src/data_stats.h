@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Running statistics of channel values, accumulated as
+ *         they are dispatched over a window of fixed length.
+ *         Accumulators only use integer arithmetic so that their
+ *         cost in dispatch is fixed. When a window is complete,
+ *         its statistics are published as a snapshot and
+ *         accumulation restarts for the next window.
+ */
+
+#ifndef DATA_STATS_H_
+#define DATA_STATS_H_
+
+
+// Stdlib
+#include <stdint.h>
+
+// ARM CMSIS library
+#include <arm_math.h>
+
+
+/////
+// Type definitions
+
+// Window length is limited so that the sum of
+// 16-bit values fits in a 32-bit accumulator.
+static const uint32_t STATS_MAX_WINDOW = 65536;
+
+typedef struct
+{
+	uint16_t min;            // Minimum raw value
+	uint16_t max;            // Maximum raw value
+	uint32_t count;          // Number of values in the window
+	uint32_t sum;            // Sum of raw values
+	uint64_t sum_squares;    // Sum of squared raw values
+	uint32_t window_number;  // Number of windows completed since configuration
+} stats_snapshot_t;
+
+typedef struct
+{
+	uint32_t window;          // Window length, 0 if statistics are disabled
+	uint16_t min;             // Accumulators of current window
+	uint16_t max;
+	uint32_t count;
+	uint32_t sum;
+	uint64_t sum_squares;
+
+	stats_snapshot_t snapshot; // Latest completed window
+} stats_state_t;
+
+
+/////
+// API
+
+/**
+ * @brief Configure statistics accumulation.
+ *        Any previous accumulation is discarded.
+ *
+ * @param stats Statistics to configure.
+ * @param window Number of values in a window, from 1 to
+ *        STATS_MAX_WINDOW, or 0 to disable statistics.
+ *
+ * @return 0 if statistics were configured, -1 if window is invalid.
+ */
+int8_t data_stats_configure(stats_state_t* stats, uint32_t window);
+
+/**
+ * @brief Push a new value in statistics accumulators.
+ *        This function is called by dispatch for each value.
+ *
+ * @param stats Statistics to push the value into.
+ * @param value Raw value.
+ */
+__STATIC_FORCEINLINE void data_stats_push(stats_state_t* stats, uint16_t value)
+{
+	if (value < stats->min)
+	{
+		stats->min = value;
+	}
+	if (value > stats->max)
+	{
+		stats->max = value;
+	}
+
+	stats->sum         += value;
+	stats->sum_squares += (uint32_t)value * value;
+	stats->count++;
+
+	if (stats->count == stats->window)
+	{
+		stats->snapshot.min         = stats->min;
+		stats->snapshot.max         = stats->max;
+		stats->snapshot.count       = stats->count;
+		stats->snapshot.sum         = stats->sum;
+		stats->snapshot.sum_squares = stats->sum_squares;
+		stats->snapshot.window_number++;
+
+		stats->min         = UINT16_MAX;
+		stats->max         = 0;
+		stats->count       = 0;
+		stats->sum         = 0;
+		stats->sum_squares = 0;
+	}
+}
+
+
+#endif // DATA_STATS_H_
@@ -34,6 +34,9 @@
 // STM32
 #include <stm32_ll_dma.h>
 
+// OwnTech API
+#include "dma_channels.h"
+
 // Current module private functions
 #include "data_dispatch.h"
 
@@ -67,6 +70,12 @@ static const uint32_t source_triggers[5] =
 
 static size_t buffers_sizes[5] = {0};
 
+// DMA 1 channel allocated to each ADC, 0 if none
+static uint8_t adc_dma_channels[5] = {0};
+
+// ADC number served by each DMA 1 channel, 0 if none
+static uint8_t dma_channels_adc[DMA_CHANNELS_COUNT] = {0};
+
 
 /////
 // Private API
@@ -84,28 +93,68 @@ static void _dma_callback(const struct device* dev, void* user_data, uint32_t dm
 	UNUSED(user_data);
 	UNUSED(status);
 
-	// DMA channel value comes raw from LL (starts at 0): convert to number
-	uint8_t channel_number = dma_channel + 1;
-	data_dispatch_do_dispatch(channel_number);
+	// DMA channel value comes raw from LL (starts at 0)
+	if (dma_channel >= DMA_CHANNELS_COUNT)
+		return;
+
+	uint8_t adc_number = dma_channels_adc[dma_channel];
+	if (adc_number != 0)
+	{
+		data_dispatch_do_dispatch(adc_number);
+	}
 }
 
+/**
+ * Get the DMA 1 channel of an ADC, allocating
+ * it on first call.
+ *
+ * @return Number of the channel, or 0 if no
+ *         channel is available.
+ */
+static uint8_t _dma_get_adc_channel(uint8_t adc_number)
+{
+	uint8_t adc_index = adc_number - 1;
 
-/////
-// Public API
+	if (adc_dma_channels[adc_index] == 0)
+	{
+		int8_t dma_channel = dma_channels_allocate();
+		if (dma_channel < 0)
+			return 0;
 
-void dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts, uint16_t* buffer, size_t buffer_size)
-{
-	// Check environment
-	if (device_is_ready(dma1) == false)
-		return;
+		adc_dma_channels[adc_index]       = dma_channel;
+		dma_channels_adc[dma_channel - 1] = adc_number;
+	}
+
+	return adc_dma_channels[adc_index];
+}
 
-	uint8_t dma_index = adc_number - 1;
-	uint32_t buffer_size_bytes = (uint32_t) buffer_size * sizeof(uint16_t);
-	buffers_sizes[dma_index] = buffer_size;
+
+/**
+ * Configure and start a DMA 1 channel to transfer
+ * values from an ADC register to a circular buffer.
+ *
+ * @param dma_channel DMA channel number (starts at 1).
+ * @param source_register Address of the ADC register.
+ * @param trigger DMAMUX request of the ADC.
+ * @param data_size Size of a single transfer in bytes.
+ * @param disable_interrupts Disable half-transfer and transfer
+ *        complete interrupts.
+ * @param buffer Destination buffer.
+ * @param buffer_size_bytes Size of the buffer in bytes.
+ */
+static void _dma_configure_channel(uint8_t  dma_channel,
+                                   uint32_t source_register,
+                                   uint32_t trigger,
+                                   uint32_t data_size,
+                                   bool     disable_interrupts,
+                                   void*    buffer,
+                                   uint32_t buffer_size_bytes)
+{
+	uint8_t dma_index = dma_channel - 1;
 
 	// Configure DMA
 	struct dma_block_config dma_block_config_s = {0};
-	dma_block_config_s.source_address   = source_registers[dma_index]; // Source: ADC DR register
+	dma_block_config_s.source_address   = source_register;             // Source: ADC data register
 	dma_block_config_s.dest_address     = (uint32_t)buffer;            // Dest: buffer in memory
 	dma_block_config_s.block_size       = buffer_size_bytes;           // Buffer size in bytes
 	dma_block_config_s.source_addr_adj  = DMA_ADDR_ADJ_NO_CHANGE;      // Source: no increment in ADC register
@@ -114,17 +163,17 @@ void dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts,
 	dma_block_config_s.source_reload_en = 1;                           // Reload source address on block completion; Enables Half-transfer interrupt
 
 	struct dma_config dma_config_s = {0};
-	dma_config_s.dma_slot            = source_triggers[dma_index]; // Trigger source: ADC
+	dma_config_s.dma_slot            = trigger;                    // Trigger source: ADC
 	dma_config_s.channel_direction   = PERIPHERAL_TO_MEMORY;       // From periph to mem
-	dma_config_s.source_data_size    = 2;                          // Source: 2 bytes (uint16_t)
-	dma_config_s.dest_data_size      = 2;                          // Dest: 2 bytes (uint16_t)
+	dma_config_s.source_data_size    = data_size;                  // Source: ADC data size
+	dma_config_s.dest_data_size      = data_size;                  // Dest: same size in memory
 	dma_config_s.source_burst_length = 1;                          // Source: No burst
 	dma_config_s.dest_burst_length   = 1;                          // Dest: No burst
 	dma_config_s.block_count         = 1;                          // 1 block
 	dma_config_s.head_block          = &dma_block_config_s;        // Block config as defined above
 	dma_config_s.dma_callback        = _dma_callback;              // DMA interrupt callback
 
-	dma_config(dma1, adc_number, &dma_config_s);
+	dma_config(dma1, dma_channel, &dma_config_s);
 
 	if (disable_interrupts == true)
 	{
@@ -132,7 +181,61 @@ void dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts,
 		LL_DMA_DisableIT_TC(DMA1, dma_index);
 	}
 
-	dma_start(dma1, adc_number);
+	dma_start(dma1, dma_channel);
+}
+
+
+/////
+// Public API
+
+int8_t dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts, uint16_t* buffer, size_t buffer_size)
+{
+	// Check environment
+	if (device_is_ready(dma1) == false)
+		return -1;
+
+	uint8_t dma_channel = _dma_get_adc_channel(adc_number);
+	if (dma_channel == 0)
+		return -1;
+
+	uint8_t adc_index = adc_number - 1;
+	uint32_t buffer_size_bytes = (uint32_t) buffer_size * sizeof(uint16_t);
+	buffers_sizes[adc_index] = buffer_size;
+
+	_dma_configure_channel(dma_channel,
+	                       source_registers[adc_index],
+	                       source_triggers[adc_index],
+	                       sizeof(uint16_t),
+	                       disable_interrupts,
+	                       buffer,
+	                       buffer_size_bytes);
+
+	return 0;
+}
+
+int8_t dma_configure_dual_adc_acquisition(bool disable_interrupts, uint32_t* buffer, size_t buffer_size)
+{
+	// Check environment
+	if (device_is_ready(dma1) == false)
+		return -1;
+
+	// Pairs are transferred on ADC 1 DMA channel and request
+	uint8_t dma_channel = _dma_get_adc_channel(1);
+	if (dma_channel == 0)
+		return -1;
+
+	uint32_t buffer_size_bytes = (uint32_t) buffer_size * sizeof(uint32_t);
+	buffers_sizes[0] = buffer_size;
+
+	_dma_configure_channel(dma_channel,
+	                       (uint32_t)(&(ADC12_COMMON->CDR)),
+	                       LL_DMAMUX_REQ_ADC1,
+	                       sizeof(uint32_t),
+	                       disable_interrupts,
+	                       buffer,
+	                       buffer_size_bytes);
+
+	return 0;
 }
 
 uint32_t dma_get_retreived_data_count(uint8_t adc_number)
@@ -142,22 +245,27 @@ uint32_t dma_get_retreived_data_count(uint8_t adc_number)
 	static int32_t previous_dma_latest_data_pointers[5] = {-1, -1, -1, -1, -1};
 
 	// Get data
-	uint32_t dma_index = adc_number - 1;
-	uint32_t dma_remaining_data = LL_DMA_GetDataLength(DMA1, dma_index);
-	int32_t previous_dma_latest_data_pointer = previous_dma_latest_data_pointers[dma_index];
+	uint32_t adc_index = adc_number - 1;
+	uint8_t  dma_channel = adc_dma_channels[adc_index];
+	if (dma_channel == 0)
+		return 0;
+
+	// LL channel index starts at 0
+	uint32_t dma_remaining_data = LL_DMA_GetDataLength(DMA1, dma_channel - 1);
+	int32_t previous_dma_latest_data_pointer = previous_dma_latest_data_pointers[adc_index];
 
 	// Compute pointers
-	int32_t dma_next_data_pointer = buffers_sizes[dma_index] - dma_remaining_data;
+	int32_t dma_next_data_pointer = buffers_sizes[adc_index] - dma_remaining_data;
 	int32_t dma_latest_data_pointer = dma_next_data_pointer - 1;
 
 	int32_t corrected_dma_pointer = dma_latest_data_pointer;
 	if (dma_latest_data_pointer < previous_dma_latest_data_pointer)
 	{
-		corrected_dma_pointer += buffers_sizes[dma_index];
+		corrected_dma_pointer += buffers_sizes[adc_index];
 	}
 
 	uint32_t retreived_data = corrected_dma_pointer - previous_dma_latest_data_pointer;
-	previous_dma_latest_data_pointers[dma_index] = dma_latest_data_pointer;
+	previous_dma_latest_data_pointers[adc_index] = dma_latest_data_pointer;
 
 	return retreived_data;
 }
@@ -24,8 +24,11 @@
  *
  * @brief  This file provides DMA configuration to automatically
  *         store ADC acquisitions in a provided buffer.
- *         DMA 1 is used for all acquisitions, with channel n
- *         acquiring values from ADC n.
+ *         DMA 1 is used for all acquisitions. Each ADC gets its
+ *         own channel from the DMA channels allocator on first
+ *         configuration, and keeps it afterwards. In dual mode,
+ *         ADC 1 channel acquires pairs of values from ADC 1 and
+ *         ADC 2.
  */
 
 #ifndef DMA_H_
@@ -50,8 +53,29 @@
  *        driver default behavior.
  * @param buffer Pointer to buffer.
  * @param buffer_size Number of uint16_t words the buffer can contain.
+ *
+ * @return 0 if acquisition was configured, -1 if DMA is not
+ *         ready or no DMA 1 channel is available.
+ */
+int8_t dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts, uint16_t* buffer, size_t buffer_size);
+
+/**
+ * @brief This function configures ADC 1 DMA 1 channel to transfer
+ * pairs of simultaneous measures from ADC 1 and ADC 2 operated
+ * in dual mode, then starts the channel. Each 32-bit word holds
+ * ADC 1 value in its low half-word and ADC 2 value in its high
+ * half-word. No DMA 1 channel is used for ADC 2 in that case.
+ *
+ * @param disable_interrupts Boolean indicating whether interrupts
+ *        shoud be disabled. Warning: this override Zephyr DMA
+ *        driver default behavior.
+ * @param buffer Pointer to buffer.
+ * @param buffer_size Number of uint32_t words the buffer can contain.
+ *
+ * @return 0 if acquisition was configured, -1 if DMA is not
+ *         ready or no DMA 1 channel is available.
  */
-void dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts, uint16_t* buffer, size_t buffer_size);
+int8_t dma_configure_dual_adc_acquisition(bool disable_interrupts, uint32_t* buffer, size_t buffer_size);
 
 /**
  * @brief Obtain the number of acquired data since
@@ -60,6 +84,7 @@ void dma_configure_adc_acquisition(uint8_t adc_number, bool disable_interrupts,
  * @param adc_number Number of the ADC.
  *
  * @return Number of acquired data modulo buffer size.
+ *         In dual mode, this is a number of pairs for ADC 1.
  */
 uint32_t dma_get_retreived_data_count(uint8_t adc_number);
 
@@ -42,6 +42,7 @@
 
 // OwnTech API
 #include "DataAPI.h"
+#include "nvs_storage.h"
 
 // Current file header
 #include "shield_channels.h"
@@ -118,10 +119,10 @@ static uint8_t available_channels_count[ADC_COUNT] = {0};
 
 // List of available channels containing 1 array for each ADC.
 // Each array contains pointers to channel definition in
-// available_channels_props array.
-// For each ADC, the array size will match the value of
-// available_channels_count for the ADC.
-static channel_prop_t** available_channels_props[ADC_COUNT] = {0};
+// dt_channels_props array.
+// For each ADC, only the first available_channels_count
+// cells of the array are used.
+static channel_prop_t* available_channels_props[ADC_COUNT][DT_CHANNELS_COUNT] = {0};
 
 // List of channels enabled by user configuration.
 // For each channel, a nullptr indicates it has not been
@@ -141,6 +142,12 @@ static bool initialized = false;
 static void _adc_channels_build_available_channels_lists()
 {
 	bool checkNvs = true;
+	uint8_t retrieved_channels_count = 0;
+	uint32_t start_cycles = k_cycle_get_32();
+
+	// Channels stored individually by a previous version are
+	// migrated to the calibration record, written once at the end
+	nvs_storage_calibration_begin();
 
 	// Retreive calibration coefficients for each channel listed in device tree
 	for (uint8_t dt_channel_index = 0 ; dt_channel_index < DT_CHANNELS_COUNT ; dt_channel_index++)
@@ -179,18 +186,7 @@ static void _adc_channels_build_available_channels_lists()
 
 			if (res == 0)
 			{
-				printk("Parameters for ADC %u channel %u have been retrieved from flash\n", dt_channels_props[dt_channel_index].adc_number, dt_channels_props[dt_channel_index].channel_number);
-				conversion_type_t conv_type = data_conversion_get_conversion_type(dt_channels_props[dt_channel_index].adc_number, dt_channels_props[dt_channel_index].channel_number);
-				switch (conv_type)
-				{
-					case conversion_linear:
-					{
-						float32_t gain   = data_conversion_get_parameter(dt_channels_props[dt_channel_index].adc_number, dt_channels_props[dt_channel_index].channel_number, 1);
-						float32_t offset = data_conversion_get_parameter(dt_channels_props[dt_channel_index].adc_number, dt_channels_props[dt_channel_index].channel_number, 2);
-						printk("    Conversion type is linear, with gain=%f and offset=%f\n", gain, offset);
-					}
-					break;
-				}
+				retrieved_channels_count++;
 				nvsRetrieved = true;
 			}
 			else if (res == -1)
@@ -234,10 +230,14 @@ static void _adc_channels_build_available_channels_lists()
 		available_channels_count[adc_index]++;
 	}
 
-	// Create the channels list for each ADC
-	for (uint8_t adc_index = 0 ; adc_index < ADC_COUNT ; adc_index++)
+	nvs_storage_calibration_commit();
+
+	if (retrieved_channels_count > 0)
 	{
-		available_channels_props[adc_index] = (channel_prop_t**)k_malloc(sizeof(channel_prop_t*) * available_channels_count[adc_index]);
+		printk("Parameters for %u channels have been retrieved from flash in %u us\n",
+		       retrieved_channels_count,
+		       k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles)
+		      );
 	}
 
 	// Populate the channels list for each ADC
@@ -424,6 +424,9 @@ void shield_channels_set_user_acquisition_parameters()
 	char received_char = console_getchar();
 	if (received_char == 'y')
 	{
+		// Write calibration record once for all channels
+		nvs_storage_calibration_begin();
+
 		channel_info = shield_channels_get_enabled_channel_info(V_HIGH);
 		int8_t err = data_conversion_store_channel_parameters_in_nvs(channel_info.adc_num, channel_info.channel_num);
 
@@ -442,6 +445,8 @@ void shield_channels_set_user_acquisition_parameters()
 		channel_info = shield_channels_get_enabled_channel_info(I2_LOW);
 		err |= data_conversion_store_channel_parameters_in_nvs(channel_info.adc_num, channel_info.channel_num);
 
+		err |= nvs_storage_calibration_commit();
+
 		if (err == 0)
 		{
 			printk("Parameters were successfully written in permanent storage.\n");
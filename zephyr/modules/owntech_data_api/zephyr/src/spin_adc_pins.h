@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Mapping of Spin header pins to ADC channels.
+ *         The table is generated at build time from the
+ *         adc-pins property of the spin_header device tree
+ *         node, so that looking up the channel connected to
+ *         a pin only costs an indexed load. The Spin header
+ *         node is shared by all boards running on the Spin
+ *         pinout, including nucleo_g474re.
+ */
+
+#ifndef SPIN_ADC_PINS_H_
+#define SPIN_ADC_PINS_H_
+
+
+// Stdlib
+#include <stdint.h>
+#include <stddef.h>
+
+// Zephyr
+#include <zephyr/devicetree.h>
+
+
+/////
+// Device-tree related macros
+
+#define SPIN_HEADER_NODE DT_NODELABEL(spin_header)
+
+
+/////
+// Constants definitions
+
+// Spin header pins are numbered from 1 to 59
+static const uint8_t SPIN_PINS_COUNT = 60;
+
+static const uint8_t SPIN_ADC_COUNT = 5;
+
+
+/////
+// Types definition
+
+typedef struct
+{
+	uint8_t channel_num[SPIN_ADC_COUNT][SPIN_PINS_COUNT];
+} spin_adc_pins_table_t;
+
+
+/////
+// Table generation
+
+// Boards without Spin header have no pin connected to an ADC
+#define SPIN_ADC_PINS_NONE {0, 0, 0}
+
+static constexpr uint8_t spin_adc_pins_triplets[] = DT_PROP_OR(SPIN_HEADER_NODE, adc_pins, SPIN_ADC_PINS_NONE);
+
+static_assert(sizeof(spin_adc_pins_triplets) % 3 == 0,
+              "Spin header adc-pins property must be a list of <pin adc channel> triplets");
+
+/**
+ * Build the pin to channel table from device tree triplets.
+ * Pins not connected to an ADC are mapped to channel 0.
+ */
+static constexpr spin_adc_pins_table_t _spin_adc_pins_build_table()
+{
+	spin_adc_pins_table_t table = {};
+
+	for (size_t i = 0 ; i + 2 < sizeof(spin_adc_pins_triplets) ; i += 3)
+	{
+		uint8_t pin_num     = spin_adc_pins_triplets[i];
+		uint8_t adc_num     = spin_adc_pins_triplets[i+1];
+		uint8_t channel_num = spin_adc_pins_triplets[i+2];
+
+		if ( (adc_num >= 1) && (adc_num <= SPIN_ADC_COUNT) && (pin_num < SPIN_PINS_COUNT) )
+		{
+			table.channel_num[adc_num-1][pin_num] = channel_num;
+		}
+	}
+
+	return table;
+}
+
+static constexpr spin_adc_pins_table_t spin_adc_pins_table = _spin_adc_pins_build_table();
+
+
+/////
+// API
+
+/**
+ * @brief  Get the ADC channel connected to a Spin header pin.
+ *
+ * @param  adc_num Number of the ADC.
+ * @param  pin_num Number of the pin on the Spin headers.
+ * @return Number of the channel, or 0 if the pin is not
+ *         connected to the ADC.
+ */
+static constexpr uint8_t spin_adc_pins_get_channel_number(uint8_t adc_num, uint8_t pin_num)
+{
+	uint8_t adc_index = adc_num - 1;
+	if ( (adc_index >= SPIN_ADC_COUNT) || (pin_num >= SPIN_PINS_COUNT) )
+		return 0;
+
+	return spin_adc_pins_table.channel_num[adc_index][pin_num];
+}
+
+
+#endif // SPIN_ADC_PINS_H_
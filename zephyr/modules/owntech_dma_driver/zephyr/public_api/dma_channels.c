@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+// Current file header
+#include "dma_channels.h"
+
+
+/////
+// Local variables
+
+// Bit n is set when channel n+1 is reserved
+static atomic_t reserved_channels = ATOMIC_INIT(0);
+
+
+/////
+// Public API
+
+int8_t dma_channels_reserve(uint8_t dma_channel)
+{
+	if ( (dma_channel == 0) || (dma_channel > DMA_CHANNELS_COUNT) )
+		return -1;
+
+	if (atomic_test_and_set_bit(&reserved_channels, dma_channel-1) == true)
+		return -1;
+
+	return 0;
+}
+
+int8_t dma_channels_allocate()
+{
+	for (uint8_t dma_channel = 1 ; dma_channel <= DMA_CHANNELS_COUNT ; dma_channel++)
+	{
+		if (atomic_test_and_set_bit(&reserved_channels, dma_channel-1) == false)
+			return dma_channel;
+	}
+
+	return -1;
+}
+
+void dma_channels_release(uint8_t dma_channel)
+{
+	if ( (dma_channel == 0) || (dma_channel > DMA_CHANNELS_COUNT) )
+		return;
+
+	atomic_clear_bit(&reserved_channels, dma_channel-1);
+}
+
+bool dma_channels_is_reserved(uint8_t dma_channel)
+{
+	if ( (dma_channel == 0) || (dma_channel > DMA_CHANNELS_COUNT) )
+		return false;
+
+	return atomic_test_bit(&reserved_channels, dma_channel-1);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ *
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Allocator of DMA 1 channels. DMA 1 is shared between
+ *         ADC acquisition and communication peripherals: each
+ *         user must reserve the channels it uses, either by
+ *         number if its code depends on a specific channel, or
+ *         by letting the allocator pick the first free one.
+ *
+ *         Channel numbers start at 1, as in Zephyr DMA API.
+ */
+
+#ifndef DMA_CHANNELS_H_
+#define DMA_CHANNELS_H_
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/////
+// Constants
+
+#define DMA_CHANNELS_COUNT 8
+
+
+/////
+// API
+
+/**
+ * @brief Reserve a specific DMA 1 channel.
+ *
+ * @param dma_channel Number of the channel, from 1 to 8.
+ *
+ * @return 0 if channel was reserved, -1 if it is
+ *         already in use or does not exist.
+ */
+int8_t dma_channels_reserve(uint8_t dma_channel);
+
+/**
+ * @brief Reserve the first free DMA 1 channel.
+ *
+ * @return Number of the reserved channel, or -1 if
+ *         all channels are in use.
+ */
+int8_t dma_channels_allocate();
+
+/**
+ * @brief Release a DMA 1 channel previously reserved.
+ *
+ * @param dma_channel Number of the channel.
+ */
+void dma_channels_release(uint8_t dma_channel);
+
+/**
+ * @brief Check if a DMA 1 channel is reserved.
+ *
+ * @param dma_channel Number of the channel.
+ */
+bool dma_channels_is_reserved(uint8_t dma_channel);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMA_CHANNELS_H_
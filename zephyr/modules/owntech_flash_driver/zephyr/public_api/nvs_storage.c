@@ -28,6 +28,9 @@
 /////
 // Include
 
+// Stdlib
+#include <string.h>
+
 // Zephyr
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
@@ -35,6 +38,8 @@
 #include <zephyr/drivers/flash.h>
 #include <zephyr/storage/flash_map.h>
 
+#include <zephyr/sys/crc.h>
+
 // CMSIS
 #include <arm_math.h>
 
@@ -47,6 +52,31 @@ static const uint16_t current_storage_version = 0x0001;
 static uint16_t storage_version_in_nvs = 0;
 static bool initialized = false;
 
+// Calibration record, held in RAM once read
+#define CALIBRATION_RECORD_SIZE CONFIG_OWNTECH_NVS_CALIBRATION_RECORD_SIZE
+
+typedef struct __packed
+{
+	uint16_t format_version;
+	uint16_t payload_size;
+	uint32_t crc;
+} calibration_header_t;
+
+typedef struct __packed
+{
+	uint16_t data_id;
+	uint8_t  data_size;
+} calibration_entry_t;
+
+static const uint16_t calibration_format_version = 0x0001;
+static uint8_t calibration_record[CALIBRATION_RECORD_SIZE];
+static bool    calibration_loaded = false;
+static bool    calibration_valid  = false;
+static bool    calibration_batch  = false; // Writes are deferred to commit
+static bool    calibration_failed = false; // An update of current batch failed
+static bool    calibration_dirty  = false; // Record in RAM differs from NVS
+static bool    calibration_legacy = false; // Record holds entries migrated from individual records
+
 // Device-tree related macros
 #define NVS_PARTITION storage_partition
 #define STORAGE_NODE  DT_NODE_BY_FIXED_PARTITION_LABEL(NVS_PARTITION)
@@ -147,10 +177,108 @@ static int8_t _nvs_storage_init()
 }
 
 
+/**
+ * Read the calibration record from NVS. This is done only once,
+ * subsequent accesses to calibration entries are done in RAM.
+ */
+static void _nvs_storage_load_calibration()
+{
+	calibration_loaded = true;
+	calibration_valid  = false;
+
+	calibration_header_t* header = (calibration_header_t*)calibration_record;
+
+	int rc = -1;
+	if ( (initialized == true) || (_nvs_storage_init() == 0) )
+	{
+		// Read record at once: size is checked afterwards
+		rc = nvs_read(&fs, CALIBRATION_RECORD, calibration_record, CALIBRATION_RECORD_SIZE);
+	}
+
+	if ( (rc < (int)sizeof(calibration_header_t)) || (rc > CALIBRATION_RECORD_SIZE) ||
+	     (header->format_version != calibration_format_version) ||
+	     (rc != (int)(sizeof(calibration_header_t) + header->payload_size)) ||
+	     (header->crc != crc32_ieee(&calibration_record[sizeof(calibration_header_t)], header->payload_size)) )
+	{
+		// Start from an empty record
+		header->format_version = calibration_format_version;
+		header->payload_size   = 0;
+		return;
+	}
+
+	calibration_valid = true;
+}
+
+/**
+ * Find an entry in the calibration record.
+ *
+ * @return Offset of the entry in the record, or -1 if not found.
+ */
+static int _nvs_storage_find_calibration_entry(uint16_t data_id)
+{
+	calibration_header_t* header = (calibration_header_t*)calibration_record;
+
+	size_t offset = sizeof(calibration_header_t);
+	size_t end    = sizeof(calibration_header_t) + header->payload_size;
+	while (offset + sizeof(calibration_entry_t) <= end)
+	{
+		calibration_entry_t* entry = (calibration_entry_t*)&calibration_record[offset];
+		if (entry->data_id == data_id)
+		{
+			return offset;
+		}
+		offset += sizeof(calibration_entry_t) + entry->data_size;
+	}
+
+	return -1;
+}
+
+/**
+ * Write the calibration record in NVS. Once written, individual
+ * records migrated to the calibration record are deleted.
+ */
+static int8_t _nvs_storage_write_calibration()
+{
+	calibration_header_t* header = (calibration_header_t*)calibration_record;
+
+	header->crc = crc32_ieee(&calibration_record[sizeof(calibration_header_t)], header->payload_size);
+
+	int rc = nvs_storage_store_data(CALIBRATION_RECORD, calibration_record, sizeof(calibration_header_t) + header->payload_size);
+	if (rc < 0)
+	{
+		// Record in RAM no longer matches NVS
+		calibration_loaded = false;
+		calibration_dirty  = false;
+		return -1;
+	}
+
+	calibration_valid = true;
+	calibration_dirty = false;
+
+	if (calibration_legacy == true)
+	{
+		// Entries are now safely stored: remove their individual records.
+		// Deleting an ID that has no individual record does not write NVS.
+		size_t offset = sizeof(calibration_header_t);
+		size_t end    = sizeof(calibration_header_t) + header->payload_size;
+		while (offset + sizeof(calibration_entry_t) <= end)
+		{
+			calibration_entry_t* entry = (calibration_entry_t*)&calibration_record[offset];
+			nvs_delete(&fs, entry->data_id);
+			offset += sizeof(calibration_entry_t) + entry->data_size;
+		}
+
+		calibration_legacy = false;
+	}
+
+	return 0;
+}
+
+
 /////
 // Public Functions
 
-int8_t nvs_storage_store_data(uint16_t data_id, const void* data, uint8_t data_size)
+int nvs_storage_store_data(uint16_t data_id, const void* data, uint16_t data_size)
 {
 	if (initialized == false)
 	{
@@ -169,7 +297,7 @@ int8_t nvs_storage_store_data(uint16_t data_id, const void* data, uint8_t data_s
 	return rc;
 }
 
-int8_t nvs_storage_retrieve_data(uint16_t data_id, void* data_buffer, uint8_t data_buffer_size)
+int nvs_storage_retrieve_data(uint16_t data_id, void* data_buffer, uint16_t data_buffer_size)
 {
 	if (initialized == false)
 	{
@@ -201,6 +329,11 @@ int8_t nvs_storage_clear_all_stored_data()
 		if (error != 0) return 0;
 	}
 
+	// Forget cached calibration record
+	calibration_loaded = false;
+	calibration_dirty  = false;
+	calibration_legacy = false;
+
 	return nvs_clear(&fs);
 }
 
@@ -225,3 +358,103 @@ uint16_t nvs_storage_get_version_in_nvs()
 
 	return storage_version_in_nvs;
 }
+
+int nvs_storage_calibration_get(uint16_t data_id, void* data_buffer, uint8_t data_buffer_size)
+{
+	if (calibration_loaded == false)
+	{
+		_nvs_storage_load_calibration();
+	}
+
+	if (calibration_valid == false)
+		return -1;
+
+	int offset = _nvs_storage_find_calibration_entry(data_id);
+	if (offset < 0)
+		return -2;
+
+	calibration_entry_t* entry = (calibration_entry_t*)&calibration_record[offset];
+	if (entry->data_size > data_buffer_size)
+		return -3;
+
+	memcpy(data_buffer, &calibration_record[offset + sizeof(calibration_entry_t)], entry->data_size);
+
+	return entry->data_size;
+}
+
+int8_t nvs_storage_calibration_set(uint16_t data_id, const void* data, uint8_t data_size)
+{
+	if (calibration_loaded == false)
+	{
+		_nvs_storage_load_calibration();
+	}
+
+	calibration_header_t* header = (calibration_header_t*)calibration_record;
+
+	// Remove previous entry
+	int offset = _nvs_storage_find_calibration_entry(data_id);
+	if (offset >= 0)
+	{
+		calibration_entry_t* entry = (calibration_entry_t*)&calibration_record[offset];
+		size_t entry_size  = sizeof(calibration_entry_t) + entry->data_size;
+		size_t record_size = sizeof(calibration_header_t) + header->payload_size;
+
+		memmove(&calibration_record[offset], &calibration_record[offset + entry_size], record_size - offset - entry_size);
+		header->payload_size -= entry_size;
+	}
+
+	// Append new entry
+	size_t record_size = sizeof(calibration_header_t) + header->payload_size;
+	if (record_size + sizeof(calibration_entry_t) + data_size > CALIBRATION_RECORD_SIZE)
+	{
+		// Record in RAM no longer matches NVS
+		calibration_loaded = false;
+		calibration_dirty  = false;
+		calibration_failed = calibration_batch;
+		return -1;
+	}
+
+	calibration_entry_t* entry = (calibration_entry_t*)&calibration_record[record_size];
+	entry->data_id   = data_id;
+	entry->data_size = data_size;
+	memcpy(&calibration_record[record_size + sizeof(calibration_entry_t)], data, data_size);
+
+	header->payload_size += sizeof(calibration_entry_t) + data_size;
+
+	calibration_dirty = true;
+
+	if (calibration_batch == true)
+		return 0;
+
+	return _nvs_storage_write_calibration();
+}
+
+int8_t nvs_storage_calibration_migrate(uint16_t data_id, const void* data, uint8_t data_size)
+{
+	int8_t rc = nvs_storage_calibration_set(data_id, data, data_size);
+	if (rc == 0)
+	{
+		calibration_legacy = true;
+	}
+
+	return rc;
+}
+
+void nvs_storage_calibration_begin()
+{
+	calibration_batch  = true;
+	calibration_failed = false;
+}
+
+int8_t nvs_storage_calibration_commit()
+{
+	calibration_batch = false;
+
+	if (calibration_failed == true)
+		return -1;
+
+	if (calibration_dirty == false)
+		return 0;
+
+	return _nvs_storage_write_calibration();
+}
@@ -45,18 +45,71 @@ typedef enum
 	VERSION          = 0x0100,
 	ADC_CALIBRATION  = 0x0200,
 	MEASURE_THRESHOLD = 0x0300,
+	CALIBRATION_RECORD = 0x0400,
 }nvs_category_t;
 
 /////
 // API
 
-int8_t nvs_storage_store_data(uint16_t data_id, const void* data, uint8_t data_size);
-int8_t nvs_storage_retrieve_data(uint16_t data_id, void* data_buffer, uint8_t data_buffer_size);
+int nvs_storage_store_data(uint16_t data_id, const void* data, uint16_t data_size);
+int nvs_storage_retrieve_data(uint16_t data_id, void* data_buffer, uint16_t data_buffer_size);
 int8_t nvs_storage_clear_all_stored_data();
 
 uint16_t nvs_storage_get_current_version();
 uint16_t nvs_storage_get_version_in_nvs();
 
+/**
+ * Calibration record: calibration entries of all modules are
+ * gathered in a single NVS record, protected by a CRC. The record
+ * is read once with a single NVS access, and entries are then
+ * retrieved from RAM. Entries use the same IDs as individual records.
+ */
+
+/**
+ * @brief Get an entry from the calibration record.
+ *
+ * @return Size of the entry, or negative value if there was an error:
+ *         -1: Calibration record is absent or corrupted
+ *         -2: Entry is not in calibration record
+ *         -3: Provided buffer is too small
+ */
+int nvs_storage_calibration_get(uint16_t data_id, void* data_buffer, uint8_t data_buffer_size);
+
+/**
+ * @brief Add or update an entry in the calibration record,
+ *        then write the record in NVS. Between calls to
+ *        nvs_storage_calibration_begin() and
+ *        nvs_storage_calibration_commit(), the record is only
+ *        updated in RAM.
+ *
+ * @return 0 if entry was stored, -1 otherwise.
+ */
+int8_t nvs_storage_calibration_set(uint16_t data_id, const void* data, uint8_t data_size);
+
+/**
+ * @brief Add to the calibration record an entry read from an
+ *        individual record stored by a previous version. The
+ *        individual record is deleted once the calibration
+ *        record has been written.
+ *
+ * @return 0 if entry was stored, -1 otherwise.
+ */
+int8_t nvs_storage_calibration_migrate(uint16_t data_id, const void* data, uint8_t data_size);
+
+/**
+ * @brief Start a batch of calibration entries updates:
+ *        the record will be written once, on commit.
+ */
+void nvs_storage_calibration_begin();
+
+/**
+ * @brief End a batch of calibration entries updates and
+ *        write the record in NVS if it was modified.
+ *
+ * @return 0 if record is up to date in NVS, -1 otherwise.
+ */
+int8_t nvs_storage_calibration_commit();
+
 
 #ifdef __cplusplus
 }
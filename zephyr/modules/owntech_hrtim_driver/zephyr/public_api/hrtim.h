@@ -309,6 +309,21 @@ uint16_t hrtim_period_get(hrtim_tu_number_t tu_number);
  */
 uint16_t hrtim_period_Master_get();
 
+/**
+ * @brief   Returns the current counter value of the master timer
+ *
+ * @return    Counter of the master timer, in the same unit as its period
+ */
+uint16_t hrtim_cnt_Master_get();
+
+/**
+ * @brief   Returns the prescaler of the master timer. Master timer
+ *          counter is incremented every 2^ckpsc / 32 HRTIM clock cycles.
+ *
+ * @return    Prescaler of the master timer (CKPSC field)
+ */
+uint8_t hrtim_ckpsc_Master_get();
+
 /**
  * @brief   Returns the period of a given timing unit in microseconds
  *
@@ -624,6 +639,36 @@ void hrtim_PeriodicEvent_SetRep(hrtim_tu_t tu, uint32_t repetition);
  */
 uint32_t hrtim_PeriodicEvent_GetRep(hrtim_tu_t tu);
 
+/**
+ * @brief Checks if a periodic event occurred and was not handled yet.
+ *        When called at the end of the event callback, this means
+ *        the callback lasted longer than the event period.
+ * @param tu_src timing unit which is the source for the ISR
+ *         @arg @ref MSTR
+ *         @arg @ref TIMA
+ *         @arg @ref TIMB
+ *         @arg @ref TIMC
+ *         @arg @ref TIMD
+ *         @arg @ref TIME
+ *         @arg @ref TIMF
+ * @return true if an event is pending.
+ */
+bool hrtim_PeriodicEvent_is_pending(hrtim_tu_t tu);
+
+/**
+ * @brief Discards a pending periodic event, so that the
+ *        callback is not called for it.
+ * @param tu_src timing unit which is the source for the ISR
+ *         @arg @ref MSTR
+ *         @arg @ref TIMA
+ *         @arg @ref TIMB
+ *         @arg @ref TIMC
+ *         @arg @ref TIMD
+ *         @arg @ref TIME
+ *         @arg @ref TIMF
+ */
+void hrtim_PeriodicEvent_clear_pending(hrtim_tu_t tu);
+
 /**
  * @brief   Initializes dual DAC reset and trigger. The selected timing unit CMP2
  *          will trigger the step (Decrement/Increment of sawtooth) and the reset
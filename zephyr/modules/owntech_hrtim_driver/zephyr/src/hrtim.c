@@ -546,6 +546,16 @@ inline uint16_t hrtim_period_Master_get()
     return timerMaster.pwm_conf.period;
 }
 
+uint16_t hrtim_cnt_Master_get()
+{
+    return LL_HRTIM_TIM_GetCounter(HRTIM1, LL_HRTIM_TIMER_MASTER);
+}
+
+uint8_t hrtim_ckpsc_Master_get()
+{
+    return timerMaster.pwm_conf.ckpsc;
+}
+
 inline uint16_t hrtim_period_get(hrtim_tu_number_t tu_number)
 {
     return tu_channel[tu_number]->pwm_conf.period; // returns the value of the period
@@ -892,6 +902,24 @@ uint32_t hrtim_PeriodicEvent_GetRep(hrtim_tu_t tu)
     return LL_HRTIM_TIM_GetRepetition(HRTIM1, tu) + 1;
 }
 
+bool hrtim_PeriodicEvent_is_pending(hrtim_tu_t tu)
+{
+    if (LL_HRTIM_GetSyncInSrc(HRTIM1) == LL_HRTIM_SYNCIN_SRC_EXTERNAL_EVENT)
+        return LL_HRTIM_IsActiveFlag_SYNC(HRTIM1) != 0;
+
+    return LL_HRTIM_IsActiveFlag_REP(HRTIM1, tu) != 0;
+}
+
+void hrtim_PeriodicEvent_clear_pending(hrtim_tu_t tu)
+{
+    if (LL_HRTIM_GetSyncInSrc(HRTIM1) == LL_HRTIM_SYNCIN_SRC_EXTERNAL_EVENT)
+        LL_HRTIM_ClearFlag_SYNC(HRTIM1);
+    else
+        LL_HRTIM_ClearFlag_REP(HRTIM1, tu);
+
+    NVIC_ClearPendingIRQ(HRTIM_IRQ_NUMBER);
+}
+
 void DualDAC_init(hrtim_tu_number_t tu_number)
 {
     LL_HRTIM_TIM_SetDualDacResetTrigger(HRTIM1, tu_channel[tu_number]->pwm_conf.pwm_tu, LL_HRTIM_DCDR_COUNTER);
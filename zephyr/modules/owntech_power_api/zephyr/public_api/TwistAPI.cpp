@@ -30,38 +30,6 @@
 
 TwistAPI twist;
 
-hrtim_tu_number_t TwistAPI::spinNumberToTu(uint16_t spin_number)
-{
-    if(spin_number == 12 || spin_number == 14)
-    {
-        return PWMA;
-    }
-    else if(spin_number == 15)
-    {
-        return PWMB;
-    }
-    else if(spin_number == 2 || spin_number == 4)
-    {
-        return PWMC;
-    }
-    else if(spin_number == 5 || spin_number == 6)
-    {
-        return PWMD;
-    }
-    else if(spin_number == 10 || spin_number == 11)
-    {
-        return PWME;
-    }
-    else if(spin_number == 7 || spin_number == 9)
-    {
-        return PWMF;
-    }
-    else
-    {
-        return PWMA;
-    }
-}
-
 void TwistAPI::setVersion(twist_version_t twist_ver)
 {
     if (twist_init == false)
@@ -76,9 +44,9 @@ void TwistAPI::initLegMode(leg_t leg, hrtim_switch_convention_t leg_convention,
 
     spin.pwm.setFrequency(timer_frequency); // Configure PWM frequency
 
-    spin.pwm.setModulation(spinNumberToTu(dt_pwm_pin[leg]), dt_modulation[leg]); // Set modulation
+    spin.pwm.setModulation(dt_leg_tu[leg], dt_modulation[leg]); // Set modulation
 
-    spin.pwm.setAdcEdgeTrigger(spinNumberToTu(dt_pwm_pin[leg]), dt_edge_trigger[leg]); // Configure ADC rollover in center aligned mode
+    spin.pwm.setAdcEdgeTrigger(dt_leg_tu[leg], dt_edge_trigger[leg]); // Configure ADC rollover in center aligned mode
 
 
     /**
@@ -102,22 +70,22 @@ void TwistAPI::initLegMode(leg_t leg, hrtim_switch_convention_t leg_convention,
     if (leg_mode == CURRENT_MODE)
     {
         if (dt_current_pin[leg] == CM_DAC3)
-            spin.pwm.setEev(spinNumberToTu(dt_pwm_pin[leg]), EEV4);
+            spin.pwm.setEev(dt_leg_tu[leg], EEV4);
         else if (dt_current_pin[leg] == CM_DAC1)
-            spin.pwm.setEev(spinNumberToTu(dt_pwm_pin[leg]), EEV5);
+            spin.pwm.setEev(dt_leg_tu[leg], EEV5);
 
         /* Configure current mode */
-        spin.pwm.setMode(spinNumberToTu(dt_pwm_pin[leg]), CURRENT_MODE);
+        spin.pwm.setMode(dt_leg_tu[leg], CURRENT_MODE);
 
     }
 
-    spin.pwm.setSwitchConvention(spinNumberToTu(dt_pwm_pin[leg]), leg_convention); // choose which output of the timer unit to control whith duty cycle
+    spin.pwm.setSwitchConvention(dt_leg_tu[leg], leg_convention); // choose which output of the timer unit to control whith duty cycle
 
-    spin.pwm.initUnit(spinNumberToTu(dt_pwm_pin[leg])); // Initialize leg unit
+    spin.pwm.initUnit(dt_leg_tu[leg]); // Initialize leg unit
 
-    spin.pwm.setPhaseShift(spinNumberToTu(dt_pwm_pin[leg]), dt_phase_shift[leg]); // Configure PWM initial phase shift
+    spin.pwm.setPhaseShift(dt_leg_tu[leg], dt_phase_shift[leg]); // Configure PWM initial phase shift
 
-    spin.pwm.setDeadTime(spinNumberToTu(dt_pwm_pin[leg]), dt_rising_deadtime[leg], dt_falling_deadtime[leg]); // Configure PWM dead time
+    spin.pwm.setDeadTime(dt_leg_tu[leg], dt_rising_deadtime[leg], dt_falling_deadtime[leg]); // Configure PWM dead time
 
     /**
      * Configure PWM adc trigger.
@@ -125,11 +93,11 @@ void TwistAPI::initLegMode(leg_t leg, hrtim_switch_convention_t leg_convention,
      */
     if (dt_adc[leg] != ADCTRIG_NONE)
     {
-        spin.pwm.setAdcDecimation(spinNumberToTu(dt_pwm_pin[leg]), dt_adc_decim[leg]);
+        spin.pwm.setAdcDecimation(dt_leg_tu[leg], dt_adc_decim[leg]);
 
-        spin.pwm.setAdcTrigger(spinNumberToTu(dt_pwm_pin[leg]), dt_adc[leg]);
+        spin.pwm.setAdcTrigger(dt_leg_tu[leg], dt_adc[leg]);
 
-        spin.pwm.enableAdcTrigger(spinNumberToTu(dt_pwm_pin[leg]));
+        spin.pwm.enableAdcTrigger(dt_leg_tu[leg]);
     }
 
     /**
@@ -140,24 +108,24 @@ void TwistAPI::initLegMode(leg_t leg, hrtim_switch_convention_t leg_convention,
 
         if (dt_current_pin[leg] == CM_DAC1)
         {
-            spin.dac.currentModeInit( 1, tu_channel[spinNumberToTu(dt_pwm_pin[leg])]->pwm_conf.pwm_tu);
+            spin.dac.currentModeInit( 1, tu_channel[dt_leg_tu[leg]]->pwm_conf.pwm_tu);
             spin.comp.initialize(3);
         }
 
         else if (dt_current_pin[leg] == CM_DAC3)
         {
-            spin.dac.currentModeInit( 3, tu_channel[spinNumberToTu(dt_pwm_pin[leg])]->pwm_conf.pwm_tu);
+            spin.dac.currentModeInit( 3, tu_channel[dt_leg_tu[leg]]->pwm_conf.pwm_tu);
             spin.comp.initialize(1);
         }
     }
     /**
      * Only relevant for twist and ownverter hardware, to enable optocouplers for mosfet driver
      */
-    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMA)
+    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMA)
         spin.gpio.configurePin(PC12, OUTPUT);
-    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMC)
+    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMC)
         spin.gpio.configurePin(PC13, OUTPUT);
-    else if (twist_version == shield_ownverter && spinNumberToTu(dt_pwm_pin[leg]) == PWME)
+    else if (twist_version == shield_ownverter && dt_leg_tu[leg] == PWME)
         spin.gpio.configurePin(PB7, OUTPUT);
 
     if (twist_init == false)
@@ -178,8 +146,22 @@ void TwistAPI::setLegDutyCycle(leg_t leg, float32_t duty_leg)
         duty_leg = 0.9;
     else if (duty_leg < 0.1)
         duty_leg = 0.1;
-    uint16_t value = duty_leg * tu_channel[spinNumberToTu(dt_pwm_pin[leg])]->pwm_conf.period;
-    hrtim_duty_cycle_set(spinNumberToTu(dt_pwm_pin[leg]), value);
+    uint16_t value = duty_leg * tu_channel[dt_leg_tu[leg]]->pwm_conf.period;
+    hrtim_duty_cycle_set(dt_leg_tu[leg], value);
+}
+
+void TwistAPI::setLegDutyCycleQ15(leg_t leg, q15_t duty_leg)
+{
+    /* 0.1 and 0.9 in Q15 format */
+    const q15_t duty_min = 3277;
+    const q15_t duty_max = 29491;
+
+    if (duty_leg > duty_max)
+        duty_leg = duty_max;
+    else if (duty_leg < duty_min)
+        duty_leg = duty_min;
+    uint16_t value = ((uint32_t)duty_leg * tu_channel[dt_leg_tu[leg]]->pwm_conf.period) >> 15;
+    hrtim_duty_cycle_set(dt_leg_tu[leg], value);
 }
 
 void TwistAPI::setAllDutyCycle(float32_t duty_all)
@@ -200,18 +182,18 @@ void TwistAPI::startLeg(leg_t leg)
     /**
      * Only relevant for twist hardware, to enable optocouplers for mosfet driver
      */
-    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMA)
+    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMA)
         spin.gpio.setPin(PC12);
-    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMC)
+    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMC)
         spin.gpio.setPin(PC13);
-    else if (twist_version == shield_ownverter && spinNumberToTu(dt_pwm_pin[leg]) == PWME)
+    else if (twist_version == shield_ownverter && dt_leg_tu[leg] == PWME)
         spin.gpio.setPin(PB7);
 
     /* start PWM*/
     if (!dt_output1_inactive[leg])
-        spin.pwm.startSingleOutput(spinNumberToTu(dt_pwm_pin[leg]), TIMING_OUTPUT1);
+        spin.pwm.startSingleOutput(dt_leg_tu[leg], TIMING_OUTPUT1);
     if (!dt_output2_inactive[leg])
-        spin.pwm.startSingleOutput(spinNumberToTu(dt_pwm_pin[leg]), TIMING_OUTPUT2);
+        spin.pwm.startSingleOutput(dt_leg_tu[leg], TIMING_OUTPUT2);
 }
 
 void TwistAPI::startAll()
@@ -226,17 +208,17 @@ void TwistAPI::startAll()
 void TwistAPI::stopLeg(leg_t leg)
 {
     /* Stop PWM */
-    spin.pwm.stopDualOutput(spinNumberToTu(dt_pwm_pin[leg]));
+    spin.pwm.stopDualOutput(dt_leg_tu[leg]);
 
 
     /**
      * Only relevant for twist hardware, to disable optocouplers for mosfet driver
      */
-    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMA)
+    if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMA)
         spin.gpio.resetPin(PC12);
-    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && spinNumberToTu(dt_pwm_pin[leg]) == PWMC)
+    else if ((twist_version == shield_TWIST_V1_2 || twist_version == shield_ownverter || twist_version == shield_TWIST_V1_3) && dt_leg_tu[leg] == PWMC)
         spin.gpio.resetPin(PC13);
-    else if (twist_version == shield_ownverter && spinNumberToTu(dt_pwm_pin[leg]) == PWME)
+    else if (twist_version == shield_ownverter && dt_leg_tu[leg] == PWME)
         spin.gpio.resetPin(PB7);
 }
 
@@ -279,7 +261,7 @@ void TwistAPI::setLegTriggerValue(leg_t leg, float32_t trigger_value)
         trigger_value = 0.95;
     else if (trigger_value < 0.05)
         trigger_value = 0.05;
-    spin.pwm.setAdcTriggerInstant(spinNumberToTu(dt_pwm_pin[leg]), trigger_value);
+    spin.pwm.setAdcTriggerInstant(dt_leg_tu[leg], trigger_value);
 
 }
 
@@ -297,7 +279,7 @@ void TwistAPI::setAllTriggerValue(float32_t trigger_value)
 
 void TwistAPI::setLegPhaseShift(leg_t leg, int16_t phase_shift)
 {
-    spin.pwm.setPhaseShift(spinNumberToTu(dt_pwm_pin[leg]), phase_shift);
+    spin.pwm.setPhaseShift(dt_leg_tu[leg], phase_shift);
 
 }
 
@@ -311,7 +293,7 @@ void TwistAPI::setAllPhaseShift(int16_t phase_shift)
 
 void TwistAPI::setLegDeadTime(leg_t leg, uint16_t ns_rising_dt, uint16_t ns_falling_dt)
 {
-    spin.pwm.setDeadTime(spinNumberToTu(dt_pwm_pin[leg]), ns_rising_dt, ns_falling_dt);
+    spin.pwm.setDeadTime(dt_leg_tu[leg], ns_rising_dt, ns_falling_dt);
 }
 
 void TwistAPI::setAllDeadTime(uint16_t ns_rising_dt, uint16_t ns_falling_dt)
@@ -324,7 +306,7 @@ void TwistAPI::setAllDeadTime(uint16_t ns_rising_dt, uint16_t ns_falling_dt)
 
 void TwistAPI::setLegAdcDecim(leg_t leg, uint16_t adc_decim)
 {
-    spin.pwm.setAdcDecimation(spinNumberToTu(dt_pwm_pin[leg]), adc_decim);
+    spin.pwm.setAdcDecimation(dt_leg_tu[leg], adc_decim);
 }
 
 
@@ -339,7 +321,7 @@ void TwistAPI::setAllAdcDecim(uint16_t adc_decim)
 
 void TwistAPI::initLegBuck(leg_t leg, hrtim_pwm_mode_t leg_mode)
 {
-    if (spinNumberToTu(dt_pwm_pin[leg]) == PWMA && twist_version == shield_TWIST_V1_2)
+    if (dt_leg_tu[leg] == PWMA && twist_version == shield_TWIST_V1_2)
         initLegMode(leg, PWMx2, leg_mode);
     else
         initLegMode(leg, PWMx1, leg_mode);
@@ -356,7 +338,7 @@ void TwistAPI::initAllBuck(hrtim_pwm_mode_t leg_mode)
 
 void TwistAPI::initLegBoost(leg_t leg)
 {
-    if (spinNumberToTu(dt_pwm_pin[leg]) == PWMA && twist_version == shield_TWIST_V1_2)
+    if (dt_leg_tu[leg] == PWMA && twist_version == shield_TWIST_V1_2)
         initLegMode(leg, PWMx1, VOLTAGE_MODE);
     else
         initLegMode(leg, PWMx2, VOLTAGE_MODE);
@@ -61,8 +61,6 @@ private:
 	twist_version_t twist_version = shield_other; // shield version
 	bool twist_init = false;						// check if shield version has been initalized or not
 
-	hrtim_tu_number_t spinNumberToTu(uint16_t spin_number); // return timing unit from spin pin number
-
 public:
 	/**
 	 * @brief Set the hardware version of the board.
@@ -109,6 +107,17 @@ public:
 	 */
 	void setLegDutyCycle(leg_t leg, float32_t duty_leg);
 
+	/**
+	 * @brief Set the duty cycle for a specific leg's power control using a fixed-point value.
+	 *
+	 * This function is the integer-only counterpart of setLegDutyCycle(): it does
+	 * not use the FPU and its execution time does not depend on the value.
+	 *
+	 * @param leg The leg for which to set the duty cycle.
+	 * @param duty_leg The duty cycle value to set in Q15 format (clamped between 0.1 and 0.9).
+	 */
+	void setLegDutyCycleQ15(leg_t leg, q15_t duty_leg);
+
 	/**
 	 * @brief Set the duty cycle for power control of all the legs.
 	 *
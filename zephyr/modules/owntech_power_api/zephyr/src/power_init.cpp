@@ -27,6 +27,7 @@
 
 uint32_t timer_frequency = DT_PROP(POWER_SHIELD_ID, frequency);
 uint16_t dt_pwm_pin[] = { DT_FOREACH_CHILD_STATUS_OKAY(POWER_SHIELD_ID, LEG_PWM_PIN) };
+const hrtim_tu_number_t dt_leg_tu[] = { DT_FOREACH_CHILD_STATUS_OKAY(POWER_SHIELD_ID, LEG_TU) };
 hrtim_adc_trigger_t dt_adc[] = { DT_FOREACH_CHILD_STATUS_OKAY(POWER_SHIELD_ID, LEG_ADC) };
 uint32_t dt_adc_decim[] = {DT_FOREACH_CHILD_STATUS_OKAY(POWER_SHIELD_ID, LEG_ADC_DECIM)};
 hrtim_cnt_t dt_modulation[] = { DT_FOREACH_CHILD_STATUS_OKAY(POWER_SHIELD_ID, LEG_MODULATION) };
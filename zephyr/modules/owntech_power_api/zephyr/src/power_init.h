@@ -77,6 +77,21 @@ property from the Device Tree node with the given 'node_id'. */
  property from the Device Tree node with the given 'node_id'. */
 #define LEG_OUTPUT2(node_id) DT_PROP(node_id, output2_inactive),
 
+/* Define a macro SPIN_PIN_TO_TU that computes, at build time, the HRTIM timing unit
+driving the given spin pin number. Unknown pins default to PWMA. */
+#define SPIN_PIN_TO_TU(pin) \
+    ( ((pin) == 12 || (pin) == 14) ? PWMA : \
+      ((pin) == 15)                ? PWMB : \
+      ((pin) == 2  || (pin) == 4)  ? PWMC : \
+      ((pin) == 5  || (pin) == 6)  ? PWMD : \
+      ((pin) == 10 || (pin) == 11) ? PWME : \
+      ((pin) == 7  || (pin) == 9)  ? PWMF : \
+                                     PWMA )
+
+/* Define a macro LEG_TU that retrieves the timing unit driving the high-side
+PWM pin from the Device Tree node with the given 'node_id'. */
+#define LEG_TU(node_id)	SPIN_PIN_TO_TU(DT_PROP_BY_IDX(node_id, pwm_pin_num, 0)),
+
 #define LEG_COUNTER(node_id) +1 // this macro is needed to count the number of leg in the device tree
 
 // the shield node identifier in the device tree
@@ -101,6 +116,10 @@ extern uint32_t timer_frequency;
 properties from the children of the Device Tree node with the ID 'POWER_SHIELD_ID'. */
 extern uint16_t dt_pwm_pin[];
 
+/* Define an array 'dt_leg_tu' of type 'hrtim_tu_number_t' and initialize it at build time with the
+timing unit driving the 'pwm_pin_num' of each child of the Device Tree node with the ID 'POWER_SHIELD_ID'. */
+extern const hrtim_tu_number_t dt_leg_tu[];
+
 /* Define an array 'dt_adc' of type 'hrtim_adc_trigger_t' and initialize it with an array of
 'adc_trigger' property from the children of the Device Tree node with the ID 'POWER_SHIELD_ID'. */
 extern hrtim_adc_trigger_t dt_adc[];
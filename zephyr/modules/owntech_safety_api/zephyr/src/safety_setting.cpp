@@ -37,6 +37,7 @@
 #include "nvs_storage.h"
 #include "SpinAPI.h"
 #include "TwistAPI.h"
+#include "DataAPI.h"
 
 // Zephyr
 #include "zephyr/kernel.h"
@@ -262,7 +263,8 @@ int8_t safety_watch()
 {
     uint8_t status = 0;
 
-    for (uint8_t i = 0; i < DT_CHANNELS_NUMBER; i++)
+    // Channel 0 is UNDEFINED_CHANNEL, device tree channels range from 1 to DT_CHANNELS_NUMBER
+    for (uint8_t i = 1; i <= DT_CHANNELS_NUMBER; i++)
     {
         if (channel_watch[i])
         {
@@ -282,6 +284,12 @@ int8_t safety_watch()
 void safety_action()
 {
     twist.stopAll();
+
+#ifdef CONFIG_OWNTECH_DATA_API_CAPTURE
+    // Freeze the capture around the fault
+    data_capture_notify_event(capture_trigger_safety);
+#endif
+
     if (channel_reaction == Open_Circuit)
     {
         _open_circuit();
@@ -338,114 +346,78 @@ int8_t safety_task()
 */
 int8_t safety_store_threshold_in_nvs(channel_t channel)
 {
-	// The data structure is as follows:
-	// - 1 byte indicating the channel descriptor string size
-	// - The channel descriptor string (should be max. 23 bytes in current version)
+    // Thresholds are stored in the calibration record,
+    // with an entry structured as follows:
     // - 1 byte to store the channel number (in the order in the device tree)
-	// - 4 byte to store the channel threshold min
-	// - 4 byte to store the channel threshold max
-
-	uint8_t* buffer = (uint8_t*)k_malloc(1 + 23 + 4 + 4);
-
-    switch(channel)
-    {
-        case I1_LOW:
-            snprintk((char*)(&buffer[1]), 23, "I1_LOW_THRESHOLD");
-            break;
+    // - 4 byte to store the channel threshold min
+    // - 4 byte to store the channel threshold max
 
-        case I2_LOW:
-            snprintk((char*)(&buffer[1]), 23, "I2_LOW_THRESHOLD");
-            break;
+    uint8_t buffer[1 + 4 + 4];
 
-        case V1_LOW:
-            snprintk((char*)(&buffer[1]), 23, "V1_LOW_THRESHOLD");
-            break;
+    buffer[0] = channel;
+    memcpy(&buffer[1], &channel_threshold_min[channel], 4);
+    memcpy(&buffer[1 + 4], &channel_threshold_max[channel], 4);
 
-        case V2_LOW:
-            snprintk((char*)(&buffer[1]), 23, "V2_LOW_THRESHOLD");
-            break;
+    uint16_t channel_ID = MEASURE_THRESHOLD | (channel&0x0F);
 
-        case V_HIGH:
-            snprintk((char*)(&buffer[1]), 23, "V_HIGH_THRESHOLD");
-            break;
-
-        case I_HIGH:
-            snprintk((char*)(&buffer[1]), 23, "I_HIGH_THRESHOLD");
-            break;
+    return nvs_storage_calibration_set(channel_ID, buffer, sizeof(buffer));
+}
 
-        default:
-            snprintk((char*)(&buffer[1]), 23, "OTHER_THRESHOLD");
-            break;
+/**
+ * @brief Retrieves threshold value from the NVS
+*/
+int8_t  safety_retrieve_threshold_in_nvs(channel_t channel)
+{
+    // Checks that parameters currently stored in NVS are from the same version
+    uint16_t current_stored_version = nvs_storage_get_version_in_nvs();
+    if (current_stored_version == 0)
+    {
+        return -1;
+    }
+    else if (current_stored_version != nvs_storage_get_current_version())
+    {
+        return -2;
     }
 
-	uint8_t string_len = strlen((char*)(&buffer[1]));
+    uint16_t channel_ID = MEASURE_THRESHOLD | (channel&0x0F);
 
-	buffer[0]                                  = string_len;
-    buffer[string_len + 1]                     = channel;
-	*((float32_t*)&buffer[string_len + 2])     = channel_threshold_min[channel];
-	*((float32_t*)&buffer[string_len + 2 + 4]) = channel_threshold_max[channel];
+    // Buffer is large enough for legacy records, which are prefixed with:
+    // - 1 byte indicating the channel descriptor string size
+    // - The channel descriptor string (max. 23 bytes)
+    uint8_t buffer[1 + 23 + 1 + 4 + 4];
+    const uint8_t* entry = buffer;
+    bool legacy = false;
 
-	uint16_t channel_ID = MEASURE_THRESHOLD | (channel&0x0F);
+    int entry_size = nvs_storage_calibration_get(channel_ID, buffer, sizeof(buffer));
+    if (entry_size <= 0)
+    {
+        // Thresholds may have been stored individually by a previous version
+        int read_size = nvs_storage_retrieve_data(channel_ID, buffer, sizeof(buffer));
+        if (read_size <= 0)
+        {
+            return -4;
+        }
 
-	int ns = nvs_storage_store_data(channel_ID, buffer, 1 + string_len + 1 + 4 + 4);
+        uint8_t string_len = buffer[0];
+        entry      = &buffer[string_len + 1];
+        entry_size = read_size - (string_len + 1);
+        legacy     = true;
+    }
 
-	k_free(buffer);
+    // Check that all required values match
+    if ( (entry_size < 1 + 4 + 4) || (channel != entry[0]) )
+    {
+        return -3;
+    }
 
-	if (ns < 0)
-	{
-		return -1;
-	}
-	else
-	{
-		return 0;
-	}
-}
+    memcpy(&channel_threshold_min[channel], &entry[1], 4);
+    memcpy(&channel_threshold_max[channel], &entry[1 + 4], 4);
 
-/**
- * @brief Retrieves threshold value from the NVS
-*/
-int8_t  safety_retrieve_threshold_in_nvs(channel_t channel)
-{
-	// Checks that parameters currently stored in NVS are from the same version
-	uint16_t current_stored_version = nvs_storage_get_version_in_nvs();
-	if (current_stored_version == 0)
-	{
-		return -1;
-	}
-	else if (current_stored_version != nvs_storage_get_current_version())
-	{
-		return -2;
-	}
-
-	uint16_t channel_ID = MEASURE_THRESHOLD | (channel&0x0F);
-
-	int buffer_size = 1 + 23 + 4 + 4;
-	uint8_t* buffer = (uint8_t*)k_malloc(buffer_size);
-
-	int read_size = nvs_storage_retrieve_data(channel_ID, buffer, buffer_size);
-
-	int ret = 0;
-	if (read_size > 0)
-	{
-		uint8_t string_len = buffer[0];
-
-		// Check that all required values match
-		if (channel != buffer[string_len + 1])
-		{
-			ret = -3;
-		}
-		else
-		{
-            channel_threshold_min[channel] = *((float32_t*)&buffer[string_len + 2]);
-            channel_threshold_max[channel] = *((float32_t*)&buffer[string_len + 2 + 4]);
-		}
-	}
-	else
-	{
-		ret = -4;
-	}
-
-	k_free(buffer);
-	return ret;
-}
+    if (legacy == true)
+    {
+        // Legacy record is superseded by the calibration record entry
+        nvs_storage_calibration_migrate(channel_ID, entry, entry_size);
+    }
 
+    return 0;
+}
@@ -25,6 +25,7 @@
 
 /* Include */
 #include "safety_setting.h"
+#include "nvs_storage.h"
 
 /* Current Header */
 #include "safety_shield.h"
@@ -62,9 +63,13 @@ static threshold_prop_t dt_threshold_props[] =
 */
 void safety_init_shield(bool watch_all)
 {
+    uint8_t retrieved_thresholds_count = 0;
+
+    nvs_storage_calibration_begin();
+
     for(uint8_t i = 0; i < DT_THRESHOLDS_NUMBER; i++)
     {
-        uint8_t rc = safety_retrieve_threshold_in_nvs(dt_threshold_props[i].channel);
+        int8_t rc = safety_retrieve_threshold_in_nvs(dt_threshold_props[i].channel);
         if(rc != 0)
         {
             printk("%s value not found in static storage. Default value will be used \n", dt_threshold_props[i].name);
@@ -75,9 +80,17 @@ void safety_init_shield(bool watch_all)
         }
         else
         {
-            printk("%s value found in static storage.\n", dt_threshold_props[i].name);
+            retrieved_thresholds_count++;
         }
 
         if(watch_all) safety_set_channel_watch(&( dt_threshold_props[i].channel ), 1);
     }
+
+    // Write thresholds migrated from individual records, if any
+    nvs_storage_calibration_commit();
+
+    if(retrieved_thresholds_count > 0)
+    {
+        printk("%u threshold values found in static storage.\n", retrieved_thresholds_count);
+    }
 }
@@ -82,6 +82,38 @@ void AdcHAL::configureDiscontinuousMode(uint8_t adc_number, uint32_t discontinuo
 	adc_configure_discontinuous_mode(adc_number, discontinuous_count);
 }
 
+void AdcHAL::configureDualMode(bool enable_dual_mode)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	adc_configure_dual_mode(enable_dual_mode);
+}
+
+bool AdcHAL::getDualMode()
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_dual_mode();
+}
+
 void AdcHAL::enableChannel(uint8_t adc_num, uint8_t channel)
 {
 	/////
@@ -146,6 +178,166 @@ void AdcHAL::enableDma(uint8_t adc_num, bool use_dma)
 	adc_configure_use_dma(adc_num, use_dma);
 }
 
+int8_t AdcHAL::configureOversampling(uint8_t adc_number, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_configure_oversampling(adc_number, ratio, shift, mode);
+}
+
+uint32_t AdcHAL::getOversamplingRatio(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_oversampling_ratio(adc_number);
+}
+
+adc_ovs_mode_t AdcHAL::getOversamplingMode(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_oversampling_mode(adc_number);
+}
+
+uint8_t AdcHAL::getOversamplingExtraBits(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_oversampling_extra_bits(adc_number);
+}
+
+adc_ev_src_t AdcHAL::getTriggerSource(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_trigger_source(adc_number);
+}
+
+uint32_t AdcHAL::getDiscontinuousCount(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_discontinuous_mode(adc_number);
+}
+
+int8_t AdcHAL::enableInjectedChannel(uint8_t adc_number, uint8_t channel)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_add_injected_channel(adc_number, channel);
+}
+
+int8_t AdcHAL::configureInjectedTriggerSource(uint8_t adc_number, adc_ev_src_t trigger_source)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_configure_injected_trigger_source(adc_number, trigger_source);
+}
+
+volatile uint32_t* AdcHAL::getInjectedDataRegister(uint8_t adc_number, uint8_t rank)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	return adc_get_injected_data_register(adc_number, rank);
+}
+
+void AdcHAL::triggerSoftwareInjectedConversion(uint8_t adc_number)
+{
+	/////
+	// Make sure module is initialized
+
+	if (adcInitialized == false)
+	{
+		initializeAllAdcs();
+	}
+
+	/////
+	// Proceed
+
+	adc_trigger_software_injected_conversion(adc_number);
+}
+
 void AdcHAL::startAllAdcs()
 {
 	/////
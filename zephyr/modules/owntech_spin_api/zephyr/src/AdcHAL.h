@@ -50,7 +50,9 @@ public:
 /**
 	 * @brief Change the trigger source of an ADC.
 	 *        By default, triggger source for ADC 1/2 is on HRTIM1,
-	 *        and ADC 3/4 is software-triggered.
+	 *        and ADC 3/4/5 are software-triggered.
+	 *        Any ADC can be HRTIM-triggered: all ADCs transfer
+	 *        their values using DMA.
 	 *
 	 *        Applied configuration will only be set when ADC is started.
 	 *        If ADC is already started, it must be stopped then started again.
@@ -86,6 +88,143 @@ public:
 	 */
 	void enableDma(uint8_t adc_number, bool use_dma);
 
+	/**
+	 * @brief Add a channel to the injected sequence of an ADC.
+	 *        Injected conversions take precedence over the regular
+	 *        sequence, and their results are read directly from
+	 *        ADC registers instead of going through DMA.
+	 *        Up to 4 channels can be injected per ADC.
+	 *
+	 *        Applied configuration will only be set when ADC is started.
+	 *        If ADC is already started, it must be stopped then started again.
+	 *
+	 * @param  adc_number Number of the ADC to configure.
+	 * @param  channel Number of the channel to to be acquired.
+	 * @return Rank of the channel in the injected sequence,
+	 *         or -1 if the sequence is full.
+	 */
+	int8_t enableInjectedChannel(uint8_t adc_number, uint8_t channel);
+
+	/**
+	 * @brief Change the trigger source of the injected sequence
+	 *        of an ADC. By default, injected sequence is
+	 *        software-triggered.
+	 *
+	 *        Applied configuration will only be set when ADC is started.
+	 *        If ADC is already started, it must be stopped then started again.
+	 *
+	 * @param  adc_number Number of the ADC to configure.
+	 * @param  trigger_source Source of the trigger: hrtim_ev2,
+	 *         hrtim_ev4 or software.
+	 * @return 0 if trigger source is valid, -1 otherwise.
+	 */
+	int8_t configureInjectedTriggerSource(uint8_t adc_number, adc_ev_src_t trigger_source);
+
+	/**
+	 * @brief  Returns the address of the register holding the
+	 *         latest injected conversion result for a rank.
+	 *
+	 * @param  adc_number Number of the ADC.
+	 * @param  rank Rank in the injected sequence.
+	 * @return Address of the register, or nullptr if parameters are invalid.
+	 */
+	volatile uint32_t* getInjectedDataRegister(uint8_t adc_number, uint8_t rank);
+
+	/**
+	 * @brief  Triggers a conversion of the injected sequence of
+	 *         an ADC which is configured as software triggered.
+	 *
+	 * @param  adc_number Number of the ADC.
+	 */
+	void triggerSoftwareInjectedConversion(uint8_t adc_number);
+
+	/**
+	 * @brief Configure the hardware oversampler of an ADC.
+	 *        Each acquired value is then the sum of ratio
+	 *        conversions, right-shifted by shift, and has
+	 *        12 + log2(ratio) - shift bits.
+	 *        By default, oversampling is disabled.
+	 *
+	 *        Applied configuration will only be set when ADC is started.
+	 *        If ADC is already started, it must be stopped then started again.
+	 *
+	 * @param  adc_number Number of the ADC to configure.
+	 * @param  ratio Oversampling ratio: power of two from 2 to 256,
+	 *         or 1 to disable oversampling.
+	 * @param  shift Right shift, not exceeding log2(ratio).
+	 *         Resulting values must fit in 16 bits.
+	 * @param  mode ovs_continuous to convert the whole burst on a
+	 *         single trigger, ovs_triggered to require a trigger for
+	 *         each conversion of the burst.
+	 * @return 0 if configuration is valid, -1 otherwise.
+	 */
+	int8_t configureOversampling(uint8_t adc_number, uint32_t ratio, uint32_t shift, adc_ovs_mode_t mode = ovs_continuous);
+
+	/**
+	 * @brief  Returns the oversampling ratio of an ADC.
+	 *
+	 * @param  adc_number Number of the ADC to fetch.
+	 * @return Oversampling ratio, 1 if oversampling is disabled.
+	 */
+	uint32_t getOversamplingRatio(uint8_t adc_number);
+
+	/**
+	 * @brief  Returns the oversampling mode of an ADC.
+	 *
+	 * @param  adc_number Number of the ADC to fetch.
+	 * @return Oversampling mode.
+	 */
+	adc_ovs_mode_t getOversamplingMode(uint8_t adc_number);
+
+	/**
+	 * @brief  Returns the number of bits added to the values
+	 *         of an ADC by oversampling.
+	 *
+	 * @param  adc_number Number of the ADC to fetch.
+	 * @return Number of additional bits, 0 if oversampling is disabled.
+	 */
+	uint8_t getOversamplingExtraBits(uint8_t adc_number);
+
+	/**
+	 * @brief  Returns the trigger source of an ADC.
+	 *
+	 * @param  adc_number Number of the ADC to fetch.
+	 * @return Trigger source.
+	 */
+	adc_ev_src_t getTriggerSource(uint8_t adc_number);
+
+	/**
+	 * @brief  Returns the discontinuous count of an ADC.
+	 *
+	 * @param  adc_number Number of the ADC to fetch.
+	 * @return Discontinuous count, 0 if discontinuous mode is disabled.
+	 */
+	uint32_t getDiscontinuousCount(uint8_t adc_number);
+
+	/**
+	 * @brief Configure ADC 1 and ADC 2 in dual regular simultaneous
+	 *        mode: ADC 2 sequence is then converted at the same instant
+	 *        as ADC 1 sequence, on ADC 1 trigger, and both results are
+	 *        transferred by a single DMA request.
+	 *        Dual mode is only applied if both ADCs have the same number
+	 *        of enabled channels. By default, ADCs are independent.
+	 *
+	 *        Applied configuration will only be set when ADC is started.
+	 *        If ADC is already started, it must be stopped then started again.
+	 *
+	 * @param enable_dual_mode Set to true to enable dual mode.
+	 */
+	void configureDualMode(bool enable_dual_mode);
+
+	/**
+	 * @brief  Returns whether ADC 1 and ADC 2 are operated in
+	 *         dual regular simultaneous mode.
+	 *
+	 * @return true if dual mode is enabled and both ADCs have the
+	 *         same number of enabled channels, false otherwise.
+	 */
+	bool getDualMode();
+
 	/**
 	 * @brief Add a channel to the list of channels to be acquired
 	 *        for an ADC.
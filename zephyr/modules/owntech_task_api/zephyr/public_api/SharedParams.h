@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Consistent exchange of a set of parameters (e.g. setpoint
+ *         and gains) between background tasks and interrupts.
+ *
+ *         Parameters are held in two copies and a sequence number
+ *         tells which copy is stable: a write updates the other copy
+ *         first, switches the sequence, then updates the first copy.
+ *         Readers never block: a reader in an interrupt is never
+ *         preempted by a writer, so it always gets a consistent copy
+ *         at first try. A reader in a thread retries once if a write
+ *         completed while it was reading.
+ */
+
+#ifndef SHAREDPARAMS_H_
+#define SHAREDPARAMS_H_
+
+
+// Stdlib
+#include <stdint.h>
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+
+/////
+// Class definition
+
+template <typename T>
+class SharedParams
+{
+public:
+	SharedParams() :
+		sequence(0),
+		copies{}
+	{
+	}
+
+	explicit SharedParams(const T& initial_value) :
+		sequence(0),
+		copies{initial_value, initial_value}
+	{
+	}
+
+	/**
+	 * @brief Get a consistent copy of the parameters.
+	 *        This function can be called from any context,
+	 *        including the critical task, and never blocks.
+	 *
+	 * @return Copy of the parameters.
+	 */
+	T read() const
+	{
+		T value;
+		uint32_t start;
+
+		do
+		{
+			start = sequence;
+			compiler_barrier();
+
+			value = copies[start & 1];
+
+			compiler_barrier();
+		} while (sequence != start);
+
+		return value;
+	}
+
+	/**
+	 * @brief Replace all parameters at once.
+	 *        This function can be called from a task or a
+	 *        regular interrupt, but not from a zero-latency
+	 *        interrupt.
+	 *
+	 * @param value New value of the parameters.
+	 */
+	void write(const T& value)
+	{
+		unsigned int key = irq_lock();
+		_publish(value);
+		irq_unlock(key);
+	}
+
+	/**
+	 * @brief Modify some of the parameters, keeping others
+	 *        unchanged. Use this function rather than read()
+	 *        then write() so that concurrent modifications of
+	 *        distinct parameters are not lost.
+	 *        Same restrictions as write() apply.
+	 *
+	 * @param modifier Function or lambda with signature
+	 *        void(T&) that updates the parameters.
+	 */
+	template <typename Modifier>
+	void modify(Modifier modifier)
+	{
+		unsigned int key = irq_lock();
+
+		T value = copies[sequence & 1];
+		modifier(value);
+		_publish(value);
+
+		irq_unlock(key);
+	}
+
+private:
+	/**
+	 * Update both copies. Must be called with writers
+	 * serialized.
+	 */
+	void _publish(const T& value)
+	{
+		// Readers switch to the other copy while this one is updated
+		sequence = sequence + 1;
+		compiler_barrier();
+		copies[(sequence + 1) & 1] = value;
+		compiler_barrier();
+
+		sequence = sequence + 1;
+		compiler_barrier();
+		copies[(sequence + 1) & 1] = value;
+		compiler_barrier();
+	}
+
+	volatile uint32_t sequence;
+	T copies[2];
+};
+
+
+#endif // SHAREDPARAMS_H_
@@ -25,6 +25,9 @@
 
 // OwnTech Power API
 #include "../src/uninterruptible_synchronous_task.hpp"
+#include "../src/critical_subtasks.hpp"
+#include "../src/task_profiling.hpp"
+#include "../src/deferred_queue.hpp"
 #include "../src/asynchronous_tasks.hpp"
 
 
@@ -65,6 +68,91 @@ void TaskAPI::stopCritical()
 	scheduling_stop_uninterruptible_synchronous_task();
 }
 
+void TaskAPI::setCriticalOverrunPolicy(overrun_policy_t policy, task_function_t hook)
+{
+	scheduling_set_uninterruptible_synchronous_task_overrun_policy(policy, hook);
+}
+
+void TaskAPI::getCriticalTiming(critical_task_timing_t& timing)
+{
+	scheduling_get_uninterruptible_synchronous_task_timing(timing);
+}
+
+void TaskAPI::resetCriticalTiming()
+{
+	scheduling_reset_uninterruptible_synchronous_task_timing();
+}
+
+// Critical sub-tasks
+
+int8_t TaskAPI::createCriticalSubTask(task_function_t routine, uint32_t divider, uint32_t phase)
+{
+	return scheduling_define_critical_subtask(routine, divider, phase);
+}
+
+void TaskAPI::startCriticalSubTask(uint8_t subtask_number)
+{
+	scheduling_enable_critical_subtask(subtask_number, true);
+}
+
+void TaskAPI::stopCriticalSubTask(uint8_t subtask_number)
+{
+	scheduling_enable_critical_subtask(subtask_number, false);
+}
+
+uint32_t TaskAPI::getCriticalSubTaskOverruns(uint8_t subtask_number)
+{
+	return scheduling_get_critical_subtask_overruns(subtask_number);
+}
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+int8_t TaskAPI::getCriticalProfile(profiling_stage_t stage, task_profile_t& profile)
+{
+	return task_profiling_get_profile(stage, profile);
+}
+
+void TaskAPI::resetCriticalProfile()
+{
+	task_profiling_reset();
+}
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
+
+
+// Deferred work queue
+
+#ifdef CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+int8_t TaskAPI::postDeferred(const deferred_record_t& record)
+{
+	return deferred_queue_post(record);
+}
+
+int8_t TaskAPI::receiveDeferred(deferred_record_t& record)
+{
+	return deferred_queue_receive(record);
+}
+
+int8_t TaskAPI::waitDeferred(uint32_t timeout_ms)
+{
+	if (timeout_ms == 0)
+	{
+		return deferred_queue_wait(K_FOREVER);
+	}
+	else
+	{
+		return deferred_queue_wait(K_MSEC(timeout_ms));
+	}
+}
+
+uint32_t TaskAPI::getDeferredDroppedCount()
+{
+	return deferred_queue_get_dropped_count();
+}
+
+#endif // CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
 
 // Asynchronous tasks
 
@@ -40,6 +40,60 @@ typedef void (*task_function_t)();
 
 typedef enum { source_uninitialized, source_hrtim, source_tim6 } scheduling_interrupt_source_t;
 
+// Reaction of the critical task to an overrun
+typedef enum
+{
+	overrun_ignore = 0,  // Only count overruns
+	overrun_skip,        // Drop the late release
+	overrun_stop_power,  // Stop all power legs
+	overrun_hook         // Call a user function
+} overrun_policy_t;
+
+// Timing of the critical task, in CPU cycles
+typedef struct
+{
+	uint32_t releases;          // Number of task releases
+	uint32_t overruns;          // Number of overruns
+	int32_t  min_jitter_cycles; // Earliest release wrt. ideal period
+	int32_t  max_jitter_cycles; // Latest release wrt. ideal period
+} critical_task_timing_t;
+
+#ifdef CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+// Record handed off from critical task to background task
+typedef struct
+{
+	uint32_t id;  // User-defined record type
+	uint32_t data[CONFIG_OWNTECH_TASK_DEFERRED_RECORD_WORDS];
+} deferred_record_t;
+
+#endif // CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+// Stages of the critical task interrupt
+typedef enum
+{
+	profiling_stage_safety = 0,     // Safety check
+	profiling_stage_data_dispatch,  // Data dispatch
+	profiling_stage_user_task,      // User critical task
+	profiling_stage_subtasks,       // Critical sub-tasks
+	profiling_stage_total,          // Whole interrupt
+	profiling_stages_count
+} profiling_stage_t;
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+// Execution time statistics, in CPU cycles
+typedef struct
+{
+	uint32_t count;        // Number of executions
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint32_t mean_cycles;
+	uint32_t histogram[CONFIG_OWNTECH_TASK_PROFILING_HISTOGRAM_BINS];
+} task_profile_t;
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
+
 
 /////
 // Static class definition
@@ -107,6 +161,186 @@ public:
 	 */
 	void stopCritical();
 
+	/**
+	 * @brief Set the reaction of the critical task to an overrun.
+	 *        An overrun occurs when the critical task (including its
+	 *        sub-tasks) is still running when the next period starts.
+	 *        Overruns are always counted, whatever the policy.
+	 *
+	 * @param policy Reaction to an overrun:
+	 *        - overrun_ignore (default): task is run again as soon
+	 *          as it ends, late.
+	 *        - overrun_skip: late release is dropped, and task
+	 *          will next run on the following period.
+	 *        - overrun_stop_power: all power legs are stopped.
+	 *        - overrun_hook: hook function is called from the
+	 *          critical task interrupt.
+	 * @param hook Function to call on overrun when policy
+	 *        is overrun_hook. Ignored otherwise.
+	 */
+	void setCriticalOverrunPolicy(overrun_policy_t policy, task_function_t hook = NULL);
+
+	/**
+	 * @brief Get timing statistics of the critical task since
+	 *        it was started or statistics were last reset.
+	 *        Jitter is the difference between the actual interval
+	 *        between two releases and the task period, in CPU
+	 *        cycles (170 cycles per µs on Spin).
+	 *
+	 * @param timing Structure to fill with statistics.
+	 */
+	void getCriticalTiming(critical_task_timing_t& timing);
+
+	/**
+	 * @brief Reset timing statistics of the critical task.
+	 */
+	void resetCriticalTiming();
+
+	/**
+	 * @brief Creates a critical sub-task.
+	 *        A critical sub-task is run by the critical task interrupt,
+	 *        right after the critical task, once every `divider`
+	 *        critical task periods. This allows running slower
+	 *        control loops (e.g. voltage loop, MPPT) alongside a
+	 *        fast current loop without hand-written counters.
+	 *
+	 *        On each tick, due sub-tasks are run fastest first
+	 *        (smallest divider first). Use the phase parameter to
+	 *        spread slow sub-tasks with the same divider over
+	 *        different ticks.
+	 *
+	 *        Sub-tasks can be created at any time, but a critical
+	 *        task must be defined for them to run. They are enabled
+	 *        on creation.
+	 *
+	 * @param routine Pointer to the void(void) function
+	 *        to be executed periodically.
+	 * @param divider Sub-task period, as a number of critical task
+	 *        periods. Must be at least 1.
+	 * @param phase Index of the first critical task tick, after
+	 *        startCritical(), the sub-task runs on.
+	 *        Must be lower than divider.
+	 * @return Number assigned to the sub-task, or -1 if parameters
+	 *         are invalid or the max number of sub-tasks has been
+	 *         reached. Increase maximum number of critical sub-tasks
+	 *         in prj.conf if required.
+	 */
+	int8_t createCriticalSubTask(task_function_t routine, uint32_t divider, uint32_t phase = 0);
+
+	/**
+	 * @brief Enable a previously disabled critical sub-task.
+	 *        Sub-task keeps its phase while disabled.
+	 *
+	 * @param subtask_number Number of the sub-task, obtained
+	 *        using the createCriticalSubTask() function.
+	 */
+	void startCriticalSubTask(uint8_t subtask_number);
+
+	/**
+	 * @brief Disable a critical sub-task. The sub-task
+	 *        can be resumed by calling startCriticalSubTask().
+	 *
+	 * @param subtask_number Number of the sub-task, obtained
+	 *        using the createCriticalSubTask() function.
+	 */
+	void stopCriticalSubTask(uint8_t subtask_number);
+
+	/**
+	 * @brief Get the number of times a critical sub-task
+	 *        ended after the release of the next critical task
+	 *        period, i.e. the number of times the tick it ran on
+	 *        took longer than the critical task period.
+	 *
+	 * @param subtask_number Number of the sub-task, obtained
+	 *        using the createCriticalSubTask() function.
+	 * @return Number of overruns.
+	 */
+	uint32_t getCriticalSubTaskOverruns(uint8_t subtask_number);
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+	/**
+	 * @brief Get execution time statistics of a stage of
+	 *        the critical task interrupt, measured using the
+	 *        DWT cycle counter since the critical task was
+	 *        started or statistics were last reset.
+	 *
+	 *        Times are expressed in CPU cycles (170 cycles per
+	 *        µs on Spin). Histogram bin i counts executions
+	 *        that lasted between i and i+1 times the bin width
+	 *        (configured in prj.conf), the last bin also counting
+	 *        longer executions.
+	 *
+	 *        This function can be called from a background task.
+	 *
+	 * @param stage Stage of the critical task interrupt.
+	 * @param profile Structure to fill with statistics.
+	 * @return 0 if statistics were copied, -1 if stage is invalid.
+	 */
+	int8_t getCriticalProfile(profiling_stage_t stage, task_profile_t& profile);
+
+	/**
+	 * @brief Reset execution time statistics of all stages
+	 *        of the critical task interrupt.
+	 */
+	void resetCriticalProfile();
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
+
+
+#ifdef CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+	/**
+	 * @brief Hand off a record to a background task.
+	 *        This function never blocks and can be called from the
+	 *        critical task, e.g. to report an event or request an
+	 *        action that can't be done in the critical task
+	 *        (logging, communication, etc.)
+	 *        If the queue is full, record is dropped.
+	 *
+	 * @param record Record to post. It is copied in the queue.
+	 * @return 0 if record was posted, -1 if queue is full.
+	 */
+	int8_t postDeferred(const deferred_record_t& record);
+
+	/**
+	 * @brief Get the oldest record posted with postDeferred().
+	 *
+	 *        Records must be retrieved by a single task: do not
+	 *        call this function from several tasks.
+	 *
+	 * @param record Record to fill.
+	 * @return 0 if a record was retrieved, -1 if queue is empty.
+	 */
+	int8_t receiveDeferred(deferred_record_t& record);
+
+	/**
+	 * @brief Suspend the calling task until a record is available
+	 *        in the queue. Use this function in a background task
+	 *        instead of suspendBackgroundMs() to process records as
+	 *        soon as they are posted:
+	 *
+	 *        while (task.waitDeferred() == 0)
+	 *            while (task.receiveDeferred(record) == 0)
+	 *                process(record);
+	 *
+	 *        DO NOT use this function in a critical task!
+	 *
+	 * @param timeout_ms Maximum time to wait in milliseconds,
+	 *        0 waits forever.
+	 * @return 0 if a record is available, -1 on timeout.
+	 */
+	int8_t waitDeferred(uint32_t timeout_ms = 0);
+
+	/**
+	 * @brief Get the number of records dropped by
+	 *        postDeferred() because the queue was full.
+	 *        Increase deferred queue length in prj.conf
+	 *        if records are dropped.
+	 */
+	uint32_t getDeferredDroppedCount();
+
+#endif // CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
 
 #ifdef CONFIG_OWNTECH_TASK_ENABLE_ASYNCHRONOUS_TASKS
 
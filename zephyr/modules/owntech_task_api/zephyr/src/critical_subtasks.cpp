@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// Current file header
+#include "critical_subtasks.hpp"
+
+
+/////
+// Local variables
+
+#define MAX_SUBTASKS CONFIG_OWNTECH_TASK_MAX_CRITICAL_SUBTASKS
+
+typedef struct
+{
+	task_function_t routine;
+	uint32_t        divider;
+	uint32_t        phase;
+	uint32_t        countdown; // Ticks left before next run
+	bool            enabled;
+	uint32_t        overruns;
+} subtask_information_t;
+
+static subtask_information_t subtasks_information[MAX_SUBTASKS];
+static uint8_t subtask_count = 0;
+
+// Sub-tasks numbers, by increasing divider
+static uint8_t run_order[MAX_SUBTASKS];
+
+// Critical task period, in cycles
+static uint32_t period_cycles = 0;
+
+
+/////
+// Public API
+
+int8_t scheduling_define_critical_subtask(task_function_t routine, uint32_t divider, uint32_t phase)
+{
+	if ( (routine == NULL) || (divider == 0) || (phase >= divider) )
+		return -1;
+
+	if (subtask_count == MAX_SUBTASKS)
+		return -1;
+
+	uint8_t subtask_number = subtask_count;
+
+	subtask_information_t* subtask = &subtasks_information[subtask_number];
+	subtask->routine   = routine;
+	subtask->divider   = divider;
+	subtask->phase     = phase;
+	subtask->countdown = phase;
+	subtask->enabled   = true;
+	subtask->overruns  = 0;
+
+	// Insert in run order after all sub-tasks
+	// with a lower or equal divider.
+	unsigned int key = irq_lock();
+
+	uint8_t position = subtask_count;
+	while ( (position > 0) && (subtasks_information[run_order[position-1]].divider > divider) )
+	{
+		run_order[position] = run_order[position-1];
+		position--;
+	}
+	run_order[position] = subtask_number;
+	subtask_count++;
+
+	irq_unlock(key);
+
+	return subtask_number;
+}
+
+void scheduling_enable_critical_subtask(uint8_t subtask_number, bool enable)
+{
+	if (subtask_number >= subtask_count)
+		return;
+
+	subtasks_information[subtask_number].enabled = enable;
+}
+
+uint32_t scheduling_get_critical_subtask_overruns(uint8_t subtask_number)
+{
+	if (subtask_number >= subtask_count)
+		return 0;
+
+	return subtasks_information[subtask_number].overruns;
+}
+
+void scheduling_reset_critical_subtasks(uint32_t task_period_us)
+{
+	period_cycles = (uint32_t)(((uint64_t)task_period_us * sys_clock_hw_cycles_per_sec()) / 1000000);
+
+	for (uint8_t subtask_number = 0 ; subtask_number < subtask_count ; subtask_number++)
+	{
+		subtasks_information[subtask_number].countdown = subtasks_information[subtask_number].phase;
+	}
+}
+
+void scheduling_run_critical_subtasks(uint32_t tick_start)
+{
+	for (uint8_t i = 0 ; i < subtask_count ; i++)
+	{
+		subtask_information_t* subtask = &subtasks_information[run_order[i]];
+
+		// Countdown runs even when disabled to keep phase
+		if (subtask->countdown != 0)
+		{
+			subtask->countdown--;
+			continue;
+		}
+		subtask->countdown = subtask->divider - 1;
+
+		if (subtask->enabled == false)
+			continue;
+
+		subtask->routine();
+
+		// Sub-task ended after next critical task release
+		if (k_cycle_get_32() - tick_start > period_cycles)
+		{
+			subtask->overruns++;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Multi-rate executor for critical sub-tasks.
+ *         Sub-tasks are run by the critical task interrupt, after
+ *         the critical task itself, once every `divider` critical
+ *         task periods. They are run fastest first (rate-monotonic
+ *         order), and the phase allows spreading slow sub-tasks
+ *         over different ticks.
+ */
+
+
+#ifndef CRITICALSUBTASKS_HPP_
+#define CRITICALSUBTASKS_HPP_
+
+// Stdlib
+#include <stdint.h>
+
+// OwnTech Power API
+#include "TaskAPI.h"
+
+
+int8_t scheduling_define_critical_subtask(task_function_t routine, uint32_t divider, uint32_t phase);
+void scheduling_enable_critical_subtask(uint8_t subtask_number, bool enable);
+uint32_t scheduling_get_critical_subtask_overruns(uint8_t subtask_number);
+
+/**
+ * @brief Set period of the critical task, used as the
+ *        deadline for overrun accounting, and reset all
+ *        sub-tasks to their initial phase.
+ *        Must be called before critical task is started.
+ */
+void scheduling_reset_critical_subtasks(uint32_t task_period_us);
+
+/**
+ * @brief Run sub-tasks due on this tick.
+ *        Called by the critical task interrupt.
+ *
+ * @param tick_start Cycle count at critical task release.
+ */
+void scheduling_run_critical_subtasks(uint32_t tick_start);
+
+
+#endif // CRITICALSUBTASKS_HPP_
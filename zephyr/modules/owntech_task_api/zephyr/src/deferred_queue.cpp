@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+#ifdef CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+
+// Current file header
+#include "deferred_queue.hpp"
+
+
+/////
+// Local variables
+
+#define QUEUE_LENGTH CONFIG_OWNTECH_TASK_DEFERRED_QUEUE_LENGTH
+#define QUEUE_MASK   (QUEUE_LENGTH - 1)
+
+BUILD_ASSERT((QUEUE_LENGTH & QUEUE_MASK) == 0, "Deferred queue length must be a power of two");
+
+typedef struct
+{
+	// Position the cell is ready for: equal to enqueue position
+	// when free, to enqueue position + 1 when holding a record.
+	atomic_t          sequence;
+	deferred_record_t record;
+} queue_cell_t;
+
+static queue_cell_t queue_cells[QUEUE_LENGTH];
+
+static atomic_t enqueue_position = ATOMIC_INIT(0);
+static uint32_t dequeue_position = 0; // Only accessed by consumer
+
+static atomic_t dropped_count = ATOMIC_INIT(0);
+
+static struct k_poll_signal queue_signal = K_POLL_SIGNAL_INITIALIZER(queue_signal);
+
+
+/////
+// Private functions
+
+static int _deferred_queue_init()
+{
+	for (uint32_t i = 0 ; i < QUEUE_LENGTH ; i++)
+	{
+		atomic_set(&queue_cells[i].sequence, i);
+	}
+
+	return 0;
+}
+
+SYS_INIT(_deferred_queue_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+
+/////
+// Public API
+
+int8_t deferred_queue_post(const deferred_record_t& record)
+{
+	queue_cell_t* cell;
+	uint32_t position = (uint32_t)atomic_get(&enqueue_position);
+
+	while (1)
+	{
+		cell = &queue_cells[position & QUEUE_MASK];
+		int32_t difference = (int32_t)((uint32_t)atomic_get(&cell->sequence) - position);
+
+		if (difference == 0)
+		{
+			// Cell is free: try to reserve it
+			if (atomic_cas(&enqueue_position, position, position + 1) == true)
+				break;
+		}
+		else if (difference < 0)
+		{
+			// Cell still holds a record from previous lap: queue is full
+			atomic_inc(&dropped_count);
+			return -1;
+		}
+
+		// Another producer reserved this cell
+		position = (uint32_t)atomic_get(&enqueue_position);
+	}
+
+	cell->record = record;
+	atomic_set(&cell->sequence, position + 1);
+
+	k_poll_signal_raise(&queue_signal, 0);
+
+	return 0;
+}
+
+int8_t deferred_queue_receive(deferred_record_t& record)
+{
+	queue_cell_t* cell = &queue_cells[dequeue_position & QUEUE_MASK];
+
+	if ((uint32_t)atomic_get(&cell->sequence) != dequeue_position + 1)
+		return -1;
+
+	record = cell->record;
+	atomic_set(&cell->sequence, dequeue_position + QUEUE_LENGTH);
+	dequeue_position++;
+
+	return 0;
+}
+
+int8_t deferred_queue_wait(k_timeout_t timeout)
+{
+	// Reset before checking so that a record posted
+	// after the check wakes up the poll.
+	k_poll_signal_reset(&queue_signal);
+
+	queue_cell_t* cell = &queue_cells[dequeue_position & QUEUE_MASK];
+	if ((uint32_t)atomic_get(&cell->sequence) == dequeue_position + 1)
+		return 0;
+
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &queue_signal);
+
+	if (k_poll(&event, 1, timeout) != 0)
+		return -1;
+
+	return 0;
+}
+
+uint32_t deferred_queue_get_dropped_count()
+{
+	return (uint32_t)atomic_get(&dropped_count);
+}
+
+
+#endif // CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Bounded multi-producer single-consumer queue of
+ *         fixed-size records, used to defer work from the
+ *         critical task to a background task.
+ *
+ *         Producers reserve a cell with a compare-and-swap on
+ *         the enqueue position, then publish it by updating the
+ *         cell sequence number (Vyukov bounded queue). Producers
+ *         never wait for the consumer: when the queue is full,
+ *         the record is dropped. The consumer is woken up using
+ *         a poll signal raised on each post.
+ */
+
+
+#ifndef DEFERREDQUEUE_HPP_
+#define DEFERREDQUEUE_HPP_
+
+// Stdlib
+#include <stdint.h>
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// OwnTech Power API
+#include "TaskAPI.h"
+
+
+#ifdef CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+
+/**
+ * @brief Post a record. Can be called from any context.
+ *
+ * @return 0 if record was posted, -1 if queue is full.
+ */
+int8_t deferred_queue_post(const deferred_record_t& record);
+
+/**
+ * @brief Get the oldest record from the queue.
+ *        Must only be called from the consumer task.
+ *
+ * @return 0 if a record was retrieved, -1 if queue is empty.
+ */
+int8_t deferred_queue_receive(deferred_record_t& record);
+
+/**
+ * @brief Wait until the queue holds at least one record.
+ *        Must only be called from the consumer task.
+ *
+ * @return 0 if a record is available, -1 on timeout.
+ */
+int8_t deferred_queue_wait(k_timeout_t timeout);
+
+/**
+ * @brief Get the number of records dropped because
+ *        queue was full.
+ */
+uint32_t deferred_queue_get_dropped_count();
+
+
+#endif // CONFIG_OWNTECH_TASK_ENABLE_DEFERRED_QUEUE
+
+#endif // DEFERREDQUEUE_HPP_
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Deferred queue self-test: a critical task posts
+ *         sequence-numbered records at 20 kHz while a thread
+ *         drains them. At the end, the thread checks that
+ *         every record was either received in order or
+ *         counted as dropped, and prints throughput and
+ *         post execution time.
+ */
+
+#ifdef CONFIG_OWNTECH_TASK_DEFERRED_QUEUE_SELFTEST
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// OwnTech Power API
+#include "TaskAPI.h"
+
+
+/////
+// Local variables and constants
+
+#define SELFTEST_PERIOD_US  50 // 20 kHz
+#define SELFTEST_DURATION_S CONFIG_OWNTECH_TASK_DEFERRED_QUEUE_SELFTEST_DURATION
+#define SELFTEST_RECORD_ID  0x5E1F
+
+#define STACKSIZE 1024
+#define PRIORITY  5 // Same as background tasks
+
+static volatile uint32_t posted_count = 0;
+
+typedef struct
+{
+	uint32_t received;
+	uint32_t lost;       // Gaps in sequence numbers
+	uint32_t misordered; // Sequence numbers going backwards
+	uint32_t next_sequence;
+} selftest_results_t;
+
+static void _deferred_selftest_thread(void*, void*, void*);
+
+K_THREAD_DEFINE(deferred_selftest_id, STACKSIZE, _deferred_selftest_thread, NULL, NULL, NULL,
+                PRIORITY, 0, 1000);
+
+
+/////
+// Private functions
+
+static void _deferred_selftest_producer()
+{
+	deferred_record_t record = {};
+	record.id      = SELFTEST_RECORD_ID;
+	record.data[0] = posted_count;
+
+	posted_count = posted_count + 1;
+
+	task.postDeferred(record);
+}
+
+static void _deferred_selftest_drain(selftest_results_t& results)
+{
+	deferred_record_t record;
+
+	while (task.receiveDeferred(record) == 0)
+	{
+		if ( (record.id != SELFTEST_RECORD_ID) || (record.data[0] < results.next_sequence) )
+		{
+			results.misordered++;
+			continue;
+		}
+
+		results.lost += record.data[0] - results.next_sequence;
+		results.next_sequence = record.data[0] + 1;
+		results.received++;
+	}
+}
+
+static void _deferred_selftest_thread(void*, void*, void*)
+{
+	selftest_results_t results = {};
+
+	printk("Deferred queue self-test: posting at %u kHz for %u s\n",
+	       1000 / SELFTEST_PERIOD_US,
+	       SELFTEST_DURATION_S
+	      );
+
+	uint32_t dropped_start = task.getDeferredDroppedCount();
+
+	if (task.createCritical(_deferred_selftest_producer, SELFTEST_PERIOD_US, source_tim6) != 0)
+	{
+		printk("Deferred queue self-test: unable to create critical task\n");
+		return;
+	}
+
+	// Starting critical task also resets profiling statistics
+	task.startCritical(false);
+
+	int64_t end_time = k_uptime_get() + SELFTEST_DURATION_S * 1000;
+	while (k_uptime_get() < end_time)
+	{
+		if (task.waitDeferred(100) == 0)
+		{
+			_deferred_selftest_drain(results);
+		}
+	}
+
+	task.stopCritical();
+	_deferred_selftest_drain(results);
+
+	uint32_t posted  = posted_count;
+	uint32_t dropped = task.getDeferredDroppedCount() - dropped_start;
+
+	// Records after the last one received were dropped too
+	results.lost += posted - results.next_sequence;
+
+	printk("Deferred queue self-test: %u posted, %u received, %u dropped, %u misordered\n",
+	       posted,
+	       results.received,
+	       dropped,
+	       results.misordered
+	      );
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+	task_profile_t profile;
+	task.getCriticalProfile(profiling_stage_user_task, profile);
+	printk("Deferred queue self-test: post cycles min %u, mean %u, max %u\n",
+	       profile.min_cycles,
+	       profile.mean_cycles,
+	       profile.max_cycles
+	      );
+#endif
+
+	if ( (results.misordered == 0) && (results.lost == dropped) && (results.received + dropped == posted) )
+	{
+		printk("Deferred queue self-test: PASS\n");
+	}
+	else
+	{
+		printk("Deferred queue self-test: FAIL (%u records missing from sequence)\n",
+		       results.lost
+		      );
+	}
+}
+
+
+#endif // CONFIG_OWNTECH_TASK_DEFERRED_QUEUE_SELFTEST
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ */
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+
+// Zephyr
+#include <zephyr/kernel.h>
+
+// Current file header
+#include "task_profiling.hpp"
+
+
+/////
+// Local variables
+
+#define HISTOGRAM_BINS      CONFIG_OWNTECH_TASK_PROFILING_HISTOGRAM_BINS
+#define HISTOGRAM_BIN_SHIFT CONFIG_OWNTECH_TASK_PROFILING_HISTOGRAM_BIN_SHIFT
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t histogram[HISTOGRAM_BINS];
+} stage_statistics_t;
+
+static stage_statistics_t stages_statistics[profiling_stages_count];
+
+
+/////
+// Public API
+
+void task_profiling_init()
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	task_profiling_reset();
+}
+
+void task_profiling_reset()
+{
+	unsigned int key = irq_lock();
+
+	for (uint8_t stage = 0 ; stage < profiling_stages_count ; stage++)
+	{
+		stages_statistics[stage] = {};
+		stages_statistics[stage].min = UINT32_MAX;
+	}
+
+	irq_unlock(key);
+}
+
+int8_t task_profiling_get_profile(profiling_stage_t stage, task_profile_t& profile)
+{
+	if (stage >= profiling_stages_count)
+		return -1;
+
+	stage_statistics_t statistics;
+
+	unsigned int key = irq_lock();
+	statistics = stages_statistics[stage];
+	irq_unlock(key);
+
+	profile.count      = statistics.count;
+	profile.max_cycles = statistics.max;
+	if (statistics.count != 0)
+	{
+		profile.min_cycles  = statistics.min;
+		profile.mean_cycles = (uint32_t)(statistics.sum / statistics.count);
+	}
+	else
+	{
+		profile.min_cycles  = 0;
+		profile.mean_cycles = 0;
+	}
+
+	for (uint8_t bin = 0 ; bin < HISTOGRAM_BINS ; bin++)
+	{
+		profile.histogram[bin] = statistics.histogram[bin];
+	}
+
+	return 0;
+}
+
+void task_profiling_add_sample(profiling_stage_t stage, uint32_t cycles)
+{
+	stage_statistics_t* statistics = &stages_statistics[stage];
+
+	statistics->count++;
+	statistics->sum += cycles;
+
+	if (cycles < statistics->min)
+	{
+		statistics->min = cycles;
+	}
+	if (cycles > statistics->max)
+	{
+		statistics->max = cycles;
+	}
+
+	uint32_t bin = cycles >> HISTOGRAM_BIN_SHIFT;
+	if (bin >= HISTOGRAM_BINS)
+	{
+		bin = HISTOGRAM_BINS - 1;
+	}
+	statistics->histogram[bin]++;
+}
+
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
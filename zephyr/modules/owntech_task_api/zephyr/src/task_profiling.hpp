@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 LAAS-CNRS
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 2.1 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: LGLPV2.1
+ */
+
+/**
+ * @date   2024
+ * @author Clément Foucher <clement.foucher@laas.fr>
+ *
+ * @brief  Execution time profiling of the critical task interrupt
+ *         stages, based on the DWT cycle counter. When profiling
+ *         is disabled, instrumentation functions are empty and
+ *         compiled out of the critical task.
+ */
+
+
+#ifndef TASKPROFILING_HPP_
+#define TASKPROFILING_HPP_
+
+// Stdlib
+#include <stdint.h>
+
+// Zephyr
+#include <soc.h>
+
+// OwnTech Power API
+#include "TaskAPI.h"
+
+
+#ifdef CONFIG_OWNTECH_TASK_PROFILING
+
+/**
+ * @brief Enable the DWT cycle counter and reset statistics.
+ */
+void task_profiling_init();
+
+void task_profiling_reset();
+int8_t task_profiling_get_profile(profiling_stage_t stage, task_profile_t& profile);
+
+/**
+ * @brief Add an execution time to the statistics of a stage.
+ *        Must only be called from the critical task interrupt.
+ */
+void task_profiling_add_sample(profiling_stage_t stage, uint32_t cycles);
+
+__STATIC_FORCEINLINE uint32_t task_profiling_now()
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief Record execution time of a stage.
+ *
+ * @param stage Stage that just ended.
+ * @param stage_start Cycle count at stage start.
+ * @return Cycle count at stage end, to be used as
+ *         next stage start.
+ */
+__STATIC_FORCEINLINE uint32_t task_profiling_record(profiling_stage_t stage, uint32_t stage_start)
+{
+	uint32_t stage_end = task_profiling_now();
+	task_profiling_add_sample(stage, stage_end - stage_start);
+	return stage_end;
+}
+
+#else
+
+static inline void task_profiling_init() {}
+
+static inline uint32_t task_profiling_now()
+{
+	return 0;
+}
+
+static inline uint32_t task_profiling_record(profiling_stage_t, uint32_t)
+{
+	return 0;
+}
+
+#endif // CONFIG_OWNTECH_TASK_PROFILING
+
+
+#endif // TASKPROFILING_HPP_
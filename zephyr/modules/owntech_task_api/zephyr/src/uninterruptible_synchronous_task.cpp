@@ -26,6 +26,8 @@
 
 // Current module
 #include "scheduling_common.hpp"
+#include "critical_subtasks.hpp"
+#include "task_profiling.hpp"
 
 // OwnTech Power API
 #include "timer.h"
@@ -35,6 +37,10 @@
 #include "safety_internal.h"
 #include "SafetyAPI.h"
 
+#ifdef CONFIG_OWNTECH_POWER_API
+#include "TwistAPI.h"
+#endif
+
 /* size of stack area used by error thread */
 #define STACKSIZE 512
 #define PRIORITY 0
@@ -66,6 +72,18 @@ static uint32_t task_period = 0;
 // Safety
 static bool safety_alert = false;
 
+// Timing monitoring
+static overrun_policy_t overrun_policy = overrun_ignore;
+static task_function_t  overrun_hook   = NULL;
+
+static uint32_t period_cycles     = 0;
+static uint32_t expected_interval = 0; // Cycles expected until next release
+static uint32_t previous_release  = 0;
+static uint32_t releases_count    = 0;
+static uint32_t overruns_count    = 0;
+static int32_t  min_jitter        = 0;
+static int32_t  max_jitter        = 0;
+
 /////
 // Private API
 
@@ -95,12 +113,94 @@ void thread_error(void *, void *, void *)
 	}
 }
 
+/**
+ * Measure release jitter against ideal period.
+ */
+static void _scheduling_record_release(uint32_t release)
+{
+	if (releases_count != 0)
+	{
+		int32_t jitter = (int32_t)(release - previous_release - expected_interval);
+		if (jitter < min_jitter)
+		{
+			min_jitter = jitter;
+		}
+		if (jitter > max_jitter)
+		{
+			max_jitter = jitter;
+		}
+	}
+
+	previous_release  = release;
+	expected_interval = period_cycles;
+	releases_count++;
+}
+
+/**
+ * Check if next release occurred while task was
+ * running, and apply overrun policy if so.
+ */
+static void _scheduling_check_overrun()
+{
+	bool next_release_pending;
+	if (interrupt_source == source_hrtim)
+	{
+		next_release_pending = hrtim_PeriodicEvent_is_pending(MSTR);
+	}
+	else // (interrupt_source == source_tim6)
+	{
+		next_release_pending = timer_is_irq_pending(timer6);
+	}
+
+	if (next_release_pending == false)
+		return;
+
+	overruns_count++;
+
+	switch (overrun_policy)
+	{
+		case overrun_skip:
+			if (interrupt_source == source_hrtim)
+			{
+				hrtim_PeriodicEvent_clear_pending(MSTR);
+			}
+			else
+			{
+				timer_clear_irq_pending(timer6);
+			}
+			// Next release will be one period later
+			expected_interval += period_cycles;
+			break;
+		case overrun_stop_power:
+#ifdef CONFIG_OWNTECH_POWER_API
+			twist.stopAll();
+#endif
+			break;
+		case overrun_hook:
+			if (overrun_hook != NULL)
+			{
+				overrun_hook();
+			}
+			break;
+		default:
+			break;
+	}
+}
+
 void user_task_proxy()
 {
+	uint32_t tick_start = k_cycle_get_32();
+	uint32_t profiling_start = task_profiling_now();
+	uint32_t stage_start = profiling_start;
+
+	_scheduling_record_release(tick_start);
+
 #ifdef CONFIG_OWNTECH_SAFETY_API
 
 	if (safety_task() != 0) safety_alert = true;
 
+	stage_start = task_profiling_record(profiling_stage_safety, stage_start);
+
 #endif
 
 	if (user_periodic_task == NULL) return;
@@ -108,9 +208,20 @@ void user_task_proxy()
 	if (do_data_dispatch == true)
 	{
 		data_dispatch_do_full_dispatch();
+
+		stage_start = task_profiling_record(profiling_stage_data_dispatch, stage_start);
 	}
 
 	user_periodic_task();
+
+	stage_start = task_profiling_record(profiling_stage_user_task, stage_start);
+
+	scheduling_run_critical_subtasks(tick_start);
+
+	task_profiling_record(profiling_stage_subtasks, stage_start);
+	task_profiling_record(profiling_stage_total, profiling_start);
+
+	_scheduling_check_overrun();
 }
 
 /////
@@ -185,6 +296,10 @@ void scheduling_start_uninterruptible_synchronous_task(bool manage_data_acquisit
 	if (interrupt_source == scheduling_interrupt_source_t::source_uninitialized)
 		return;
 
+	scheduling_reset_critical_subtasks(task_period);
+	task_profiling_init();
+	scheduling_reset_uninterruptible_synchronous_task_timing();
+
 	if ( (manage_data_acquisition == true) && (data.started() == false) )
 	{
 		// If Data Acquisition has not been started yet,
@@ -256,3 +371,33 @@ void scheduling_stop_uninterruptible_synchronous_task()
 		uninterruptibleTaskStatus = task_status_t::suspended;
 	}
 }
+
+void scheduling_set_uninterruptible_synchronous_task_overrun_policy(overrun_policy_t policy, task_function_t hook)
+{
+	unsigned int key = irq_lock();
+	overrun_policy = policy;
+	overrun_hook   = hook;
+	irq_unlock(key);
+}
+
+void scheduling_get_uninterruptible_synchronous_task_timing(critical_task_timing_t& timing)
+{
+	unsigned int key = irq_lock();
+	timing.releases          = releases_count;
+	timing.overruns          = overruns_count;
+	timing.min_jitter_cycles = min_jitter;
+	timing.max_jitter_cycles = max_jitter;
+	irq_unlock(key);
+}
+
+void scheduling_reset_uninterruptible_synchronous_task_timing()
+{
+	unsigned int key = irq_lock();
+	period_cycles     = (uint32_t)(((uint64_t)task_period * sys_clock_hw_cycles_per_sec()) / 1000000);
+	expected_interval = period_cycles;
+	releases_count    = 0;
+	overruns_count    = 0;
+	min_jitter        = 0;
+	max_jitter        = 0;
+	irq_unlock(key);
+}
@@ -37,6 +37,9 @@ void scheduling_set_uninterruptible_synchronous_task_interrupt_source(scheduling
 int8_t scheduling_define_uninterruptible_synchronous_task(task_function_t periodic_task, uint32_t task_period_us);
 void scheduling_start_uninterruptible_synchronous_task(bool manage_data_acquisition);
 void scheduling_stop_uninterruptible_synchronous_task();
+void scheduling_set_uninterruptible_synchronous_task_overrun_policy(overrun_policy_t policy, task_function_t hook);
+void scheduling_get_uninterruptible_synchronous_task_timing(critical_task_timing_t& timing);
+void scheduling_reset_uninterruptible_synchronous_task_timing();
 
 
 #endif // UNINTERRUPTIBLESYNCHRONOUSTASK_HPP_
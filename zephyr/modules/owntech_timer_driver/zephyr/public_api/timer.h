@@ -99,17 +99,21 @@ struct timer_config_t
 /////
 // API
 
-typedef void     (*timer_api_config)   (const struct device* dev, const struct timer_config_t* config);
-typedef void     (*timer_api_start)    (const struct device* dev);
-typedef void     (*timer_api_stop)     (const struct device* dev);
-typedef uint32_t (*timer_api_get_count)(const struct device* dev);
+typedef void     (*timer_api_config)           (const struct device* dev, const struct timer_config_t* config);
+typedef void     (*timer_api_start)            (const struct device* dev);
+typedef void     (*timer_api_stop)             (const struct device* dev);
+typedef uint32_t (*timer_api_get_count)        (const struct device* dev);
+typedef bool     (*timer_api_is_irq_pending)   (const struct device* dev);
+typedef void     (*timer_api_clear_irq_pending)(const struct device* dev);
 
 __subsystem struct timer_driver_api
 {
-	timer_api_config    config;
-	timer_api_start     start;
-	timer_api_stop      stop;
-	timer_api_get_count get_count;
+	timer_api_config            config;
+	timer_api_start             start;
+	timer_api_stop              stop;
+	timer_api_get_count         get_count;
+	timer_api_is_irq_pending    is_irq_pending;
+	timer_api_clear_irq_pending clear_irq_pending;
 };
 
 
@@ -165,6 +169,34 @@ static inline uint32_t timer_get_count(const struct device* dev)
 	return api->get_count(dev);
 }
 
+/**
+ * Check if a periodic interrupt occurred and was not handled yet.
+ * When called at the end of the interrupt callback, this means
+ * the callback lasted longer than the interrupt period.
+ *
+ * @param  dev Zephyr device representing the timer.
+ * @return     true if an interrupt is pending.
+ */
+static inline bool timer_is_irq_pending(const struct device* dev)
+{
+	const struct timer_driver_api* api = (const struct timer_driver_api*)(dev->api);
+
+	return api->is_irq_pending(dev);
+}
+
+/**
+ * Discard a pending periodic interrupt, so that the
+ * callback is not called for it.
+ *
+ * @param dev Zephyr device representing the timer.
+ */
+static inline void timer_clear_irq_pending(const struct device* dev)
+{
+	const struct timer_driver_api* api = (const struct timer_driver_api*)(dev->api);
+
+	api->clear_irq_pending(dev);
+}
+
 
 #ifdef __cplusplus
 }
@@ -74,10 +74,12 @@ static void timer_stm32_callback(const void* arg)
 
 static const struct timer_driver_api timer_funcs =
 {
-	.config    = timer_stm32_config,
-	.start     = timer_stm32_start,
-	.stop      = timer_stm32_stop,
-	.get_count = timer_stm32_get_count
+	.config            = timer_stm32_config,
+	.start             = timer_stm32_start,
+	.stop              = timer_stm32_stop,
+	.get_count         = timer_stm32_get_count,
+	.is_irq_pending    = timer_stm32_is_irq_pending,
+	.clear_irq_pending = timer_stm32_clear_irq_pending
 };
 
 void timer_stm32_config(const struct device* dev, const struct timer_config_t* config)
@@ -202,6 +204,25 @@ uint32_t timer_stm32_get_count(const struct device* dev)
 	return LL_TIM_GetCounter(tim_dev);
 }
 
+bool timer_stm32_is_irq_pending(const struct device* dev)
+{
+	TIM_TypeDef* tim_dev = ((struct stm32_timer_driver_data*)dev->data)->timer_struct;
+
+	if (tim_dev == NULL)
+		return false;
+
+	return LL_TIM_IsActiveFlag_UPDATE(tim_dev) != 0;
+}
+
+void timer_stm32_clear_irq_pending(const struct device* dev)
+{
+	struct stm32_timer_driver_data* data = (struct stm32_timer_driver_data*)dev->data;
+
+	timer_stm32_clear(dev);
+
+	NVIC_ClearPendingIRQ(data->interrupt_line);
+}
+
 
 /////
 // Per-timer inits
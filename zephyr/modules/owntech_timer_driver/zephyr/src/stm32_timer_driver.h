@@ -85,6 +85,8 @@ void timer_stm32_start(const struct device* dev);
 void timer_stm32_stop(const struct device* dev);
 uint32_t timer_stm32_get_count(const struct device* dev);
 void timer_stm32_clear(const struct device* dev);
+bool timer_stm32_is_irq_pending(const struct device* dev);
+void timer_stm32_clear_irq_pending(const struct device* dev);
 
 void init_timer_4();
 void init_timer_6();